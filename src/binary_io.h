@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+
+/**
+ * Little-endian reading and writing of integers and strings, for the binary map save
+ * format.  Readers throw std::runtime_error when the data runs out.
+ */
+namespace binary_io
+{
+
+inline void write_u16( std::ostream &fout, const std::uint16_t v )
+{
+    const char bytes[2] = { static_cast<char>( v & 0xff ), static_cast<char>( v >> 8 ) };
+    fout.write( bytes, 2 );
+}
+
+inline void write_u32( std::ostream &fout, const std::uint32_t v )
+{
+    const char bytes[4] = {
+        static_cast<char>( v & 0xff ), static_cast<char>( ( v >> 8 ) & 0xff ),
+        static_cast<char>( ( v >> 16 ) & 0xff ), static_cast<char>( v >> 24 )
+    };
+    fout.write( bytes, 4 );
+}
+
+inline void write_i32( std::ostream &fout, const int v )
+{
+    write_u32( fout, static_cast<std::uint32_t>( v ) );
+}
+
+inline void write_string( std::ostream &fout, const std::string &s )
+{
+    write_u32( fout, s.size() );
+    fout.write( s.data(), s.size() );
+}
+
+inline void read_bytes( std::istream &fin, char *out, const std::streamsize count )
+{
+    if( !fin.read( out, count ) ) {
+        throw std::runtime_error( "binary data is truncated" );
+    }
+}
+
+inline std::uint16_t read_u16( std::istream &fin )
+{
+    unsigned char bytes[2];
+    read_bytes( fin, reinterpret_cast<char *>( bytes ), 2 );
+    return static_cast<std::uint16_t>( bytes[0] | ( bytes[1] << 8 ) );
+}
+
+inline std::uint32_t read_u32( std::istream &fin )
+{
+    unsigned char bytes[4];
+    read_bytes( fin, reinterpret_cast<char *>( bytes ), 4 );
+    return static_cast<std::uint32_t>( bytes[0] ) | ( static_cast<std::uint32_t>( bytes[1] ) << 8 ) |
+           ( static_cast<std::uint32_t>( bytes[2] ) << 16 ) | ( static_cast<std::uint32_t>( bytes[3] ) << 24 );
+}
+
+inline int read_i32( std::istream &fin )
+{
+    return static_cast<int>( read_u32( fin ) );
+}
+
+inline std::string read_string( std::istream &fin )
+{
+    std::string s( read_u32( fin ), '\0' );
+    read_bytes( fin, s.data(), s.size() );
+    return s;
+}
+
+} // namespace binary_io
@@ -349,6 +349,10 @@ void cata_tiles::load_tileset(
         tileset_ptr->get_tileset_id() == tileset_id &&
         tileset_mod_list_stamp == mod_list
       ) {
+        // game data may have been reloaded with the same mods, which can reassign int ids
+        if( !precheck ) {
+            build_tile_lookup();
+        }
         return;
     }
     // TODO: move into clear or somewhere else.
@@ -362,6 +366,7 @@ void cata_tiles::load_tileset(
     loader.load( tileset_id, precheck, /*pump_events=*/pump_events );
     tileset_ptr = std::move( new_tileset_ptr );
     tileset_mod_list_stamp = mod_list;
+    build_tile_lookup();
 
     set_draw_scale( 16 );
 
@@ -2015,19 +2020,27 @@ cata_tiles::find_tile_with_season( const std::string &id ) const
 template<typename T>
 std::optional<tile_lookup_res>
 cata_tiles::find_tile_looks_like_by_string_id( const std::string &id, TILE_CATEGORY category,
-        const int looks_like_jumps_limit ) const
+        const season_type season, const int looks_like_jumps_limit ) const
 {
     const string_id<T> s_id( id );
     if( !s_id.is_valid() ) {
         return std::nullopt;
     }
     const T &obj = s_id.obj();
-    return find_tile_looks_like( obj.looks_like, category, looks_like_jumps_limit - 1 );
+    return find_tile_looks_like( obj.looks_like, category, season, looks_like_jumps_limit - 1 );
 }
 
 std::optional<tile_lookup_res>
 cata_tiles::find_tile_looks_like( const std::string &id, TILE_CATEGORY category,
                                   const int looks_like_jumps_limit ) const
+{
+    return find_tile_looks_like( id, category, season_of_year( calendar::turn ),
+                                 looks_like_jumps_limit );
+}
+
+std::optional<tile_lookup_res>
+cata_tiles::find_tile_looks_like( const std::string &id, TILE_CATEGORY category,
+                                  const season_type season, const int looks_like_jumps_limit ) const
 {
     if( id.empty() || looks_like_jumps_limit <= 0 ) {
         return std::nullopt;
@@ -2038,24 +2051,29 @@ cata_tiles::find_tile_looks_like( const std::string &id, TILE_CATEGORY category,
     // that are valid when this metod returns. Ideally they should have the lifetime
     // that is equal or exceeds lifetime of `this` or `this::tileset_ptr`.
     // For example, `id` argument may have shorter lifetime and thus should not be returned!
-    // The result of `find_tile_with_season` is OK to be returned, because it's guaranteed to
+    // The result of `find_tile_type_by_season` is OK to be returned, because it's guaranteed to
     // return pointers to the keys and values that are stored inside the `tileset_ptr`.
-    const auto tile_with_season = find_tile_with_season( id );
+    const auto tile_with_season = tileset_ptr->find_tile_type_by_season( id, season );
     if( tile_with_season ) {
         return tile_with_season;
     }
 
     switch( category ) {
         case C_FURNITURE:
-            return find_tile_looks_like_by_string_id<furn_t>( id, category, looks_like_jumps_limit );
+            return find_tile_looks_like_by_string_id<furn_t>( id, category, season,
+                    looks_like_jumps_limit );
         case C_TERRAIN:
-            return find_tile_looks_like_by_string_id<ter_t>( id, category, looks_like_jumps_limit );
+            return find_tile_looks_like_by_string_id<ter_t>( id, category, season,
+                    looks_like_jumps_limit );
         case C_TRAP:
-            return find_tile_looks_like_by_string_id<trap>( id, category, looks_like_jumps_limit );
+            return find_tile_looks_like_by_string_id<trap>( id, category, season,
+                    looks_like_jumps_limit );
         case C_FIELD:
-            return find_tile_looks_like_by_string_id<field_type>( id, category, looks_like_jumps_limit );
+            return find_tile_looks_like_by_string_id<field_type>( id, category, season,
+                    looks_like_jumps_limit );
         case C_MONSTER:
-            return find_tile_looks_like_by_string_id<mtype>( id, category, looks_like_jumps_limit );
+            return find_tile_looks_like_by_string_id<mtype>( id, category, season,
+                    looks_like_jumps_limit );
         case C_OVERMAP_TERRAIN: {
             std::optional<tile_lookup_res> ret;
             const oter_type_str_id type_tmp( id );
@@ -2066,7 +2084,7 @@ cata_tiles::find_tile_looks_like( const std::string &id, TILE_CATEGORY category,
             int jump_limit = looks_like_jumps_limit;
             for( const std::string &looks_like : type_tmp.obj().looks_like ) {
 
-                ret = find_tile_looks_like( looks_like, category, jump_limit - 1 );
+                ret = find_tile_looks_like( looks_like, category, season, jump_limit - 1 );
                 if( ret.has_value() ) {
                     return ret;
                 }
@@ -2086,7 +2104,7 @@ cata_tiles::find_tile_looks_like( const std::string &id, TILE_CATEGORY category,
             if( !base_vpid.is_valid() ) {
                 return std::nullopt;
             }
-            return find_tile_looks_like( "vp_" + base_vpid.obj().looks_like, category,
+            return find_tile_looks_like( "vp_" + base_vpid.obj().looks_like, category, season,
                                          looks_like_jumps_limit - 1 );
         }
         case C_ITEM: {
@@ -2094,12 +2112,13 @@ cata_tiles::find_tile_looks_like( const std::string &id, TILE_CATEGORY category,
             if( !iid.is_valid() ) {
                 if( id.starts_with( "corpse_" ) ) {
                     return find_tile_looks_like(
-                               itype_corpse.str(), category, looks_like_jumps_limit - 1
+                               itype_corpse.str(), category, season, looks_like_jumps_limit - 1
                            );
                 }
                 return std::nullopt;
             }
-            return find_tile_looks_like( iid->looks_like.str(), category, looks_like_jumps_limit - 1 );
+            return find_tile_looks_like( iid->looks_like.str(), category, season,
+                                         looks_like_jumps_limit - 1 );
         }
 
         default:
@@ -2107,6 +2126,64 @@ cata_tiles::find_tile_looks_like( const std::string &id, TILE_CATEGORY category,
     }
 }
 
+static bool is_immovable_furniture( const std::string &id )
+{
+    const furn_str_id fid( id );
+    return fid.is_valid() && !fid.obj().is_movable();
+}
+
+resolved_tile_lookup cata_tiles::resolve_tile_lookup( const std::string &id,
+        TILE_CATEGORY category, const season_type season ) const
+{
+    resolved_tile_lookup ret;
+    ret.tile = find_tile_looks_like( id, category, season );
+    if( !ret.tile ) {
+        return ret;
+    }
+    ret.immovable_furniture = category == C_FURNITURE && is_immovable_furniture( ret.tile->id() );
+
+    const tile_type &tile = ret.tile->tile();
+    if( !tile.multitile ) {
+        return ret;
+    }
+    ret.subtiles.resize( num_multitile_types );
+    for( size_t i = 0; i < multitile_keys.size(); i++ ) {
+        const auto &available = tile.available_subtiles;
+        if( std::find( available.begin(), available.end(), multitile_keys[i] ) == available.end() ) {
+            continue;
+        }
+        resolved_tile_lookup &variant = ret.subtiles[i];
+        variant.tile = find_tile_looks_like( ret.tile->id() + "_" + multitile_keys[i], category,
+                                             season );
+        if( !variant.tile ) {
+            // leave the whole id to draw_from_id_string() and its fallback tiles
+            return resolved_tile_lookup();
+        }
+        variant.immovable_furniture = category == C_FURNITURE &&
+                                      is_immovable_furniture( variant.tile->id() );
+    }
+    return ret;
+}
+
+void cata_tiles::build_tile_lookup()
+{
+    for( int s = 0; s < season_type::NUM_SEASONS; s++ ) {
+        const season_type season = static_cast<season_type>( s );
+        std::vector<resolved_tile_lookup> &ters = ter_tile_lookup[season];
+        ters.clear();
+        ters.reserve( ter_t::count() );
+        for( const ter_t &t : ter_t::get_all() ) {
+            ters.push_back( resolve_tile_lookup( t.id.str(), C_TERRAIN, season ) );
+        }
+        std::vector<resolved_tile_lookup> &furns = furn_tile_lookup[season];
+        furns.clear();
+        furns.reserve( furn_t::count() );
+        for( const furn_t &f : furn_t::get_all() ) {
+            furns.push_back( resolve_tile_lookup( f.id.str(), C_FURNITURE, season ) );
+        }
+    }
+}
+
 bool cata_tiles::find_overlay_looks_like( const bool male, const std::string &overlay,
         std::string &draw_id )
 {
@@ -2192,6 +2269,59 @@ bool cata_tiles::draw_from_id_string( const std::string &id, TILE_CATEGORY categ
         }
     }
 
+    const bool immovable_furniture = category == C_FURNITURE && is_immovable_furniture( found_id );
+    return draw_found_tile( display_tile, found_id, category, pos, rota, ll,
+                            apply_night_vision_goggles, height_3d, overlay_count, as_independent_entity,
+                            immovable_furniture );
+}
+
+bool cata_tiles::draw_from_int_id( const ter_id &id, const tripoint &pos, int subtile, int rota,
+                                   lit_level ll, bool apply_night_vision_goggles, int &height_3d, int overlay_count )
+{
+    const season_type season = season_of_year( calendar::turn );
+    return draw_from_lookup( ter_tile_lookup[season], id.to_i(), id.id().str(), C_TERRAIN, pos,
+                             subtile, rota, ll, apply_night_vision_goggles, height_3d, overlay_count );
+}
+
+bool cata_tiles::draw_from_int_id( const furn_id &id, const tripoint &pos, int subtile, int rota,
+                                   lit_level ll, bool apply_night_vision_goggles, int &height_3d, int overlay_count )
+{
+    const season_type season = season_of_year( calendar::turn );
+    return draw_from_lookup( furn_tile_lookup[season], id.to_i(), id.id().str(), C_FURNITURE, pos,
+                             subtile, rota, ll, apply_night_vision_goggles, height_3d, overlay_count );
+}
+
+bool cata_tiles::draw_from_lookup( const std::vector<resolved_tile_lookup> &lookup,
+                                   const int index, const std::string &id, TILE_CATEGORY category, const tripoint &pos,
+                                   int subtile, int rota, lit_level ll, bool apply_night_vision_goggles, int &height_3d,
+                                   int overlay_count )
+{
+    if( index < 0 || static_cast<size_t>( index ) >= lookup.size() || !lookup[index].tile ) {
+        return draw_from_id_string( id, category, empty_string, pos, subtile, rota, ll,
+                                    apply_night_vision_goggles, height_3d, overlay_count );
+    }
+
+    half_open_rectangle<point> screen_bounds( o, o + point( screentile_width, screentile_height ) );
+    if( !tile_iso && !screen_bounds.contains( pos.xy() ) ) {
+        return false;
+    }
+
+    const resolved_tile_lookup *found = &lookup[index];
+    // same as the multitile check in draw_from_id_string(), but with the variant found in advance
+    if( subtile >= 0 && static_cast<size_t>( subtile ) < found->subtiles.size() &&
+        found->subtiles[subtile].tile ) {
+        found = &found->subtiles[subtile];
+    }
+    return draw_found_tile( found->tile->tile(), found->tile->id(), category, pos, rota, ll,
+                            apply_night_vision_goggles, height_3d, overlay_count, false,
+                            found->immovable_furniture );
+}
+
+bool cata_tiles::draw_found_tile( const tile_type &display_tile, const std::string &found_id,
+                                  TILE_CATEGORY category, const tripoint &pos, int rota, lit_level ll,
+                                  bool apply_night_vision_goggles, int &height_3d, int overlay_count,
+                                  const bool as_independent_entity, const bool immovable_furniture )
+{
     // translate from player-relative to screen relative tile position
     const point screen_pos = as_independent_entity ? pos.xy() : player_to_screen( pos.xy() );
 
@@ -2244,20 +2374,15 @@ bool cata_tiles::draw_from_id_string( const std::string &id, TILE_CATEGORY categ
 
         }
         break;
-        case C_FURNITURE: {
+        case C_FURNITURE:
             // If the furniture is not movable, we'll allow seeding by the position
             // since we won't get the behavior that occurs where the tile constantly
             // changes when the player grabs the furniture and drags it, causing the
             // seed to change.
-            const furn_str_id fid( found_id );
-            if( fid.is_valid() ) {
-                const furn_t &f = fid.obj();
-                if( !f.is_movable() ) {
-                    seed = simple_point_hash( here.getabs( pos ) );
-                }
+            if( immovable_furniture ) {
+                seed = simple_point_hash( here.getabs( pos ) );
             }
-        }
-        break;
+            break;
         case C_ITEM:
         case C_TRAP:
             if( seed_for_animation ) {
@@ -2680,8 +2805,8 @@ bool cata_tiles::draw_terrain( const tripoint &p, const lit_level ll, int &heigh
             if( t == t_open_air ) {
                 return draw_block( p, curses_color_to_SDL( c_cyan ), 4 );
             } else {
-                return draw_from_id_string( tname, C_TERRAIN, empty_string, p, subtile, rotation, ll,
-                                            nv_goggles_activated, height_3d, z_drop );
+                return draw_from_int_id( t, p, subtile, rotation, ll, nv_goggles_activated, height_3d,
+                                         z_drop );
             }
         }
     }
@@ -2699,19 +2824,17 @@ bool cata_tiles::draw_terrain( const tripoint &p, const lit_level ll, int &heigh
             } else {
                 get_terrain_orientation( p, rotation, subtile, terrain_override, invisible );
             }
-            const std::string &tname = t2.id().str();
             // tile overrides are never memorized
             // tile overrides are always shown with full visibility
             const lit_level lit = overridden ? lit_level::LIT : ll;
             const bool nv = overridden ? false : nv_goggles_activated;
-            return draw_from_id_string( tname, C_TERRAIN, empty_string, p, subtile, rotation, lit, nv,
-                                        height_3d, z_drop );
+            return draw_from_int_id( t2, p, subtile, rotation, lit, nv, height_3d, z_drop );
         }
     } else if( invisible[0] && has_terrain_memory_at( p ) ) {
         // try drawing memory if invisible and not overridden
         const auto &t = get_terrain_memory_at( p );
 
-        return draw_from_id_string( t.tile, C_TERRAIN, empty_string, p, t.subtile, t.rotation,
+        return draw_from_id_string( t.tile.str(), C_TERRAIN, empty_string, p, t.subtile, t.rotation,
                                     lit_level::MEMORIZED, nv_goggles_activated, height_3d, z_drop );
     }
     return false;
@@ -2730,7 +2853,7 @@ bool cata_tiles::has_terrain_memory_at( const tripoint &p ) const
 {
     if( g->u.should_show_map_memory() ) {
         const memorized_terrain_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
-        if( t.tile.starts_with( "t_" ) ) {
+        if( t.tile.str().starts_with( "t_" ) ) {
             return true;
         }
     }
@@ -2741,7 +2864,7 @@ bool cata_tiles::has_furniture_memory_at( const tripoint &p ) const
 {
     if( g->u.should_show_map_memory() ) {
         const memorized_terrain_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
-        if( t.tile.starts_with( "f_" ) ) {
+        if( t.tile.str().starts_with( "f_" ) ) {
             return true;
         }
     }
@@ -2752,7 +2875,7 @@ bool cata_tiles::has_trap_memory_at( const tripoint &p ) const
 {
     if( g->u.should_show_map_memory() ) {
         const memorized_terrain_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
-        if( t.tile.starts_with( "tr_" ) ) {
+        if( t.tile.str().starts_with( "tr_" ) ) {
             return true;
         }
     }
@@ -2763,7 +2886,7 @@ bool cata_tiles::has_vpart_memory_at( const tripoint &p ) const
 {
     if( g->u.should_show_map_memory() ) {
         const memorized_terrain_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
-        if( t.tile.starts_with( "vp_" ) ) {
+        if( t.tile.str().starts_with( "vp_" ) ) {
             return true;
         }
     }
@@ -2774,7 +2897,7 @@ memorized_terrain_tile cata_tiles::get_terrain_memory_at( const tripoint &p ) co
 {
     if( g->u.should_show_map_memory() ) {
         const memorized_terrain_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
-        if( t.tile.starts_with( "t_" ) ) {
+        if( t.tile.str().starts_with( "t_" ) ) {
             return t;
         }
     }
@@ -2785,7 +2908,7 @@ memorized_terrain_tile cata_tiles::get_furniture_memory_at( const tripoint &p )
 {
     if( g->u.should_show_map_memory() ) {
         const memorized_terrain_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
-        if( t.tile.starts_with( "f_" ) ) {
+        if( t.tile.str().starts_with( "f_" ) ) {
             return t;
         }
     }
@@ -2796,7 +2919,7 @@ memorized_terrain_tile cata_tiles::get_trap_memory_at( const tripoint &p ) const
 {
     if( g->u.should_show_map_memory() ) {
         const memorized_terrain_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
-        if( t.tile.starts_with( "tr_" ) ) {
+        if( t.tile.str().starts_with( "tr_" ) ) {
             return t;
         }
     }
@@ -2807,7 +2930,7 @@ memorized_terrain_tile cata_tiles::get_vpart_memory_at( const tripoint &p ) cons
 {
     if( g->u.should_show_map_memory() ) {
         const memorized_terrain_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
-        if( t.tile.starts_with( "vp_" ) ) {
+        if( t.tile.str().starts_with( "vp_" ) ) {
             return t;
         }
     }
@@ -2854,8 +2977,8 @@ bool cata_tiles::draw_furniture( const tripoint &p, const lit_level ll, int &hei
         }
         // draw the actual furniture if there's no override
         if( !neighborhood_overridden ) {
-            return draw_from_id_string( fname, C_FURNITURE, empty_string, p, subtile, rotation, ll,
-                                        nv_goggles_activated, height_3d, z_drop );
+            return draw_from_int_id( f, p, subtile, rotation, ll, nv_goggles_activated, height_3d,
+                                     z_drop );
         }
     }
     if( invisible[0] ? overridden : neighborhood_overridden ) {
@@ -2886,18 +3009,16 @@ bool cata_tiles::draw_furniture( const tripoint &p, const lit_level ll, int &hei
             }
 
             get_tile_values( f2.to_i(), neighborhood, subtile, rotation );
-            const std::string &fname = f2.id().str();
             // tile overrides are never memorized
             // tile overrides are always shown with full visibility
             const lit_level lit = overridden ? lit_level::LIT : ll;
             const bool nv = overridden ? false : nv_goggles_activated;
-            return draw_from_id_string( fname, C_FURNITURE, empty_string, p, subtile, rotation, lit, nv,
-                                        height_3d, z_drop );
+            return draw_from_int_id( f2, p, subtile, rotation, lit, nv, height_3d, z_drop );
         }
     } else if( invisible[0] && has_furniture_memory_at( p ) ) {
         // try drawing memory if invisible and not overridden
         const auto &t = get_furniture_memory_at( p );
-        return draw_from_id_string( t.tile, C_FURNITURE, empty_string, p, t.subtile, t.rotation,
+        return draw_from_id_string( t.tile.str(), C_FURNITURE, empty_string, p, t.subtile, t.rotation,
                                     lit_level::MEMORIZED, nv_goggles_activated, height_3d, z_drop );
     }
     return false;
@@ -2972,7 +3093,7 @@ bool cata_tiles::draw_trap( const tripoint &p, const lit_level ll, int &height_3
     } else if( invisible[0] && has_trap_memory_at( p ) ) {
         // try drawing memory if invisible and not overridden
         const auto &t = get_trap_memory_at( p );
-        return draw_from_id_string( t.tile, C_TRAP, empty_string, p, t.subtile, t.rotation,
+        return draw_from_id_string( t.tile.str(), C_TRAP, empty_string, p, t.subtile, t.rotation,
                                     lit_level::MEMORIZED, nv_goggles_activated, height_3d, z_drop );
     }
     return false;
@@ -3127,7 +3248,7 @@ bool cata_tiles::draw_vpart( const tripoint &p, lit_level ll, int &height_3d,
     } else if( invisible[0] && has_vpart_memory_at( p ) ) {
         // try drawing memory if invisible and not overridden
         const auto &t = get_vpart_memory_at( p );
-        return draw_from_id_string( t.tile, C_VEHICLE_PART, empty_string, p, t.subtile, t.rotation,
+        return draw_from_id_string( t.tile.str(), C_VEHICLE_PART, empty_string, p, t.subtile, t.rotation,
                                     lit_level::MEMORIZED, nv_goggles_activated, height_3d, z_drop );
     }
     return false;
@@ -1,8 +1,10 @@
 #pragma once
 
+#include <array>
 #include <cstddef>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <tuple>
 #include <unordered_map>
@@ -68,10 +70,10 @@ class tile_lookup_res
         tile_type *_tile;
     public:
         tile_lookup_res( const std::string &id, tile_type &tile ): _id( &id ), _tile( &tile ) {}
-        const std::string &id() {
+        const std::string &id() const {
             return *_id;
         }
-        tile_type &tile() {
+        tile_type &tile() const {
             return *_tile;
         }
 };
@@ -350,6 +352,16 @@ struct tile_search_result {
     std::string found_id;
 };
 
+/** Tile found ahead of time for one terrain or furniture id in one season. */
+struct resolved_tile_lookup {
+    /** Empty if the id has to go through @ref cata_tiles::tile_type_search for a fallback tile. */
+    std::optional<tile_lookup_res> tile;
+    /** The tile was found for furniture that can't be moved, so its variant depends on position. */
+    bool immovable_furniture = false;
+    /** Multitile variants of @ref tile indexed by subtile, empty if it isn't a multitile. */
+    std::vector<resolved_tile_lookup> subtiles;
+};
+
 class cata_tiles
 {
     public:
@@ -392,12 +404,21 @@ class cata_tiles
         std::optional<tile_lookup_res>
         find_tile_looks_like( const std::string &id, TILE_CATEGORY category,
                               int looks_like_jumps_limit = 10 ) const;
+        /** As above, but for the given season instead of the current one. */
+        std::optional<tile_lookup_res>
+        find_tile_looks_like( const std::string &id, TILE_CATEGORY category, season_type season,
+                              int looks_like_jumps_limit = 10 ) const;
 
         // this templated method is used only from it's own cpp file, so it's ok to declare it here
         template<typename T>
         std::optional<tile_lookup_res>
         find_tile_looks_like_by_string_id( const std::string &id, TILE_CATEGORY category,
-                                           int looks_like_jumps_limit ) const;
+                                           season_type season, int looks_like_jumps_limit ) const;
+
+        /** Fills @ref ter_tile_lookup and @ref furn_tile_lookup from the current tileset and game data. */
+        void build_tile_lookup();
+        resolved_tile_lookup resolve_tile_lookup( const std::string &id, TILE_CATEGORY category,
+                season_type season ) const;
 
 
         bool find_overlay_looks_like( bool male, const std::string &overlay, std::string &draw_id );
@@ -449,6 +470,31 @@ class cata_tiles
                                   const std::string &subcategory, const tripoint &pos, int subtile, int rota,
                                   lit_level ll, bool apply_night_vision_goggles, int &height_3d, int overlay_count,
                                   bool as_independent_entity = false );
+        /**
+         * @brief draw_from_id_string() for terrain and furniture, using the tiles resolved by
+         * build_tile_lookup() instead of looking the id up by string.
+         *
+         * Ids that need a fallback tile are passed on to draw_from_id_string().
+         */
+        bool draw_from_int_id( const ter_id &id, const tripoint &pos, int subtile, int rota,
+                               lit_level ll, bool apply_night_vision_goggles, int &height_3d, int overlay_count );
+        bool draw_from_int_id( const furn_id &id, const tripoint &pos, int subtile, int rota,
+                               lit_level ll, bool apply_night_vision_goggles, int &height_3d, int overlay_count );
+        bool draw_from_lookup( const std::vector<resolved_tile_lookup> &lookup, int index,
+                               const std::string &id, TILE_CATEGORY category, const tripoint &pos, int subtile,
+                               int rota, lit_level ll, bool apply_night_vision_goggles, int &height_3d,
+                               int overlay_count );
+        /**
+         * @brief Picks the sprite variant for an already found tile and calls draw_tile_at().
+         *
+         * @param found_id Id the tile was found under.
+         * @param immovable_furniture Tile is for furniture that can't be moved.
+         * @return always true
+         */
+        bool draw_found_tile( const tile_type &display_tile, const std::string &found_id,
+                              TILE_CATEGORY category, const tripoint &pos, int rota, lit_level ll,
+                              bool apply_night_vision_goggles, int &height_3d, int overlay_count,
+                              bool as_independent_entity, bool immovable_furniture );
         /**
         * @brief Draw overmap tile, if it's transparent, then draw lower tile first
         *
@@ -725,6 +771,14 @@ class cata_tiles
         const GeometryRenderer_Ptr &geometry;
         /** Currently loaded tileset. */
         std::unique_ptr<tileset> tileset_ptr;
+        /**
+         * Tiles for every terrain and furniture, indexed by season and then by int id.
+         * Rebuilt whenever a tileset is loaded, which happens after game data is finalized,
+         * so drawing the map doesn't hash id strings or walk `looks_like` chains.
+         * Entries point into @ref tileset_ptr.
+         */
+        std::array<std::vector<resolved_tile_lookup>, season_type::NUM_SEASONS> ter_tile_lookup;
+        std::array<std::vector<resolved_tile_lookup>, season_type::NUM_SEASONS> furn_tile_lookup;
         /** List of mods with which @ref tileset_ptr was loaded. */
         std::vector<mod_id> tileset_mod_list_stamp;
 
@@ -2,11 +2,14 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <ostream>
 #include <string>
 #include <utility>
 
+#include "coordinate_conversions.h"
 #include "debug.h"
+#include "line.h"
 #include "mongroup.h"
 #include "monster.h"
 #include "mtype.h"
@@ -32,6 +35,61 @@ shared_ptr_fast<monster> Creature_tracker::find( const tripoint &pos ) const
     return nullptr;
 }
 
+std::vector<shared_ptr_fast<monster>> Creature_tracker::find_in_range( const tripoint &min,
+                                   const tripoint &max ) const
+{
+    std::vector<shared_ptr_fast<monster>> result;
+    const auto add_from = [&]( const std::vector<shared_ptr_fast<monster>> &bucket ) {
+        for( const shared_ptr_fast<monster> &mon_ptr : bucket ) {
+            const tripoint &pos = mon_ptr->pos();
+            if( !mon_ptr->is_dead() &&
+                pos.x >= min.x && pos.x <= max.x && pos.y >= min.y && pos.y <= max.y &&
+                pos.z >= min.z && pos.z <= max.z ) {
+                result.push_back( mon_ptr );
+            }
+        }
+    };
+
+    const tripoint min_sm = ms_to_sm_copy( min );
+    const tripoint max_sm = ms_to_sm_copy( max );
+    const int64_t num_submaps = static_cast<int64_t>( max_sm.x - min_sm.x + 1 ) *
+                                ( max_sm.y - min_sm.y + 1 ) * ( max_sm.z - min_sm.z + 1 );
+    if( num_submaps > static_cast<int64_t>( monsters_by_submap.size() ) ) {
+        // Big box, fewer occupied submaps than there are submaps to look up
+        for( const auto &pair : monsters_by_submap ) {
+            const tripoint &sm = pair.first;
+            if( sm.x >= min_sm.x && sm.x <= max_sm.x && sm.y >= min_sm.y && sm.y <= max_sm.y &&
+                sm.z >= min_sm.z && sm.z <= max_sm.z ) {
+                add_from( pair.second );
+            }
+        }
+        return result;
+    }
+
+    for( int z = min_sm.z; z <= max_sm.z; z++ ) {
+        for( int y = min_sm.y; y <= max_sm.y; y++ ) {
+            for( int x = min_sm.x; x <= max_sm.x; x++ ) {
+                const auto iter = monsters_by_submap.find( tripoint( x, y, z ) );
+                if( iter != monsters_by_submap.end() ) {
+                    add_from( iter->second );
+                }
+            }
+        }
+    }
+    return result;
+}
+
+std::vector<shared_ptr_fast<monster>> Creature_tracker::find_in_radius( const tripoint &center,
+                                   const int radius, const int z_radius ) const
+{
+    std::vector<shared_ptr_fast<monster>> result = find_in_range(
+                center - tripoint( radius, radius, z_radius ), center + tripoint( radius, radius, z_radius ) );
+    std::erase_if( result, [&center, radius]( const shared_ptr_fast<monster> &mon_ptr ) {
+        return rl_dist( center.xy(), mon_ptr->pos().xy() ) > radius;
+    } );
+    return result;
+}
+
 int Creature_tracker::temporary_id( const monster &critter ) const
 {
     const auto iter = std::find_if( monsters_list.begin(), monsters_list.end(),
@@ -86,7 +144,7 @@ bool Creature_tracker::add( const shared_ptr_fast<monster> &critter_ptr )
     }
 
     monsters_list.emplace_back( critter_ptr );
-    monsters_by_location[critter.pos()] = critter_ptr;
+    set_location( critter.pos(), critter_ptr );
     add_to_faction_map( critter_ptr );
     return true;
 }
@@ -164,8 +222,11 @@ bool Creature_tracker::update_pos( const monster &critter, const tripoint &new_p
         return ptr.get() == &critter;
     } );
     if( iter != monsters_list.end() ) {
-        monsters_by_location.erase( critter.pos() );
-        monsters_by_location[new_pos] = *iter;
+        const auto old_iter = monsters_by_location.find( critter.pos() );
+        if( old_iter != monsters_by_location.end() ) {
+            erase_location( old_iter );
+        }
+        set_location( new_pos, *iter );
         return true;
     } else {
         const tripoint &old_pos = critter.pos();
@@ -180,11 +241,39 @@ bool Creature_tracker::update_pos( const monster &critter, const tripoint &new_p
     }
 }
 
+void Creature_tracker::set_location( const tripoint &pos,
+                                     const shared_ptr_fast<monster> &critter )
+{
+    const auto iter = monsters_by_location.find( pos );
+    if( iter != monsters_by_location.end() ) {
+        erase_location( iter );
+    }
+    monsters_by_location[pos] = critter;
+    monsters_by_submap[ms_to_sm_copy( pos )].push_back( critter );
+}
+
+void Creature_tracker::erase_location( decltype( monsters_by_location )::iterator iter )
+{
+    const auto sm_iter = monsters_by_submap.find( ms_to_sm_copy( iter->first ) );
+    if( sm_iter != monsters_by_submap.end() ) {
+        std::vector<shared_ptr_fast<monster>> &bucket = sm_iter->second;
+        const auto mon_iter = std::find( bucket.begin(), bucket.end(), iter->second );
+        if( mon_iter != bucket.end() ) {
+            *mon_iter = std::move( bucket.back() );
+            bucket.pop_back();
+        }
+        if( bucket.empty() ) {
+            monsters_by_submap.erase( sm_iter );
+        }
+    }
+    monsters_by_location.erase( iter );
+}
+
 void Creature_tracker::remove_from_location_map( const monster &critter )
 {
     const auto pos_iter = monsters_by_location.find( critter.pos() );
     if( pos_iter != monsters_by_location.end() && pos_iter->second.get() == &critter ) {
-        monsters_by_location.erase( pos_iter );
+        erase_location( pos_iter );
         return;
     }
 
@@ -195,7 +284,7 @@ void Creature_tracker::remove_from_location_map( const monster &critter )
         return v.second.get() == &critter;
     } );
     if( iter != monsters_by_location.end() ) {
-        monsters_by_location.erase( iter );
+        erase_location( iter );
     }
 }
 
@@ -228,6 +317,7 @@ void Creature_tracker::clear()
 {
     monsters_list.clear();
     monsters_by_location.clear();
+    monsters_by_submap.clear();
     monster_faction_map_.clear();
     removed_.clear();
 }
@@ -235,9 +325,10 @@ void Creature_tracker::clear()
 void Creature_tracker::rebuild_cache()
 {
     monsters_by_location.clear();
+    monsters_by_submap.clear();
     monster_faction_map_.clear();
     for( const shared_ptr_fast<monster> &mon_ptr : monsters_list ) {
-        monsters_by_location[mon_ptr->pos()] = mon_ptr;
+        set_location( mon_ptr->pos(), mon_ptr );
         add_to_faction_map( mon_ptr );
     }
 }
@@ -256,13 +347,13 @@ void Creature_tracker::swap_positions( monster &first, monster &second )
     shared_ptr_fast<monster> first_ptr;
     if( first_iter != monsters_by_location.end() ) {
         first_ptr = first_iter->second;
-        monsters_by_location.erase( first_iter );
+        erase_location( first_iter );
     }
 
     shared_ptr_fast<monster> second_ptr;
     if( second_iter != monsters_by_location.end() ) {
         second_ptr = second_iter->second;
-        monsters_by_location.erase( second_iter );
+        erase_location( second_iter );
     }
     // implied: (first_ptr != second_ptr) or (first_ptr == nullptr && second_ptr == nullptr)
 
@@ -272,10 +363,10 @@ void Creature_tracker::swap_positions( monster &first, monster &second )
 
     // If the pointers have been taken out of the list, put them back in.
     if( first_ptr ) {
-        monsters_by_location[first.pos()] = first_ptr;
+        set_location( first.pos(), first_ptr );
     }
     if( second_ptr ) {
-        monsters_by_location[second.pos()] = second_ptr;
+        set_location( second.pos(), second_ptr );
     }
 }
 
@@ -47,6 +47,20 @@ class Creature_tracker
          * Dead monsters are ignored and not returned.
          */
         shared_ptr_fast<monster> find( const tripoint &pos ) const;
+        /**
+         * Returns the monsters inside the box from @p min to @p max, bounds included.
+         * Only the submaps overlapping the box are searched, not the whole monster list.
+         * Dead monsters are ignored and not returned.
+         */
+        std::vector<shared_ptr_fast<monster>> find_in_range( const tripoint &min,
+                                           const tripoint &max ) const;
+        /**
+         * Returns the monsters at most @p radius tiles (by @ref rl_dist) away from @p center
+         * horizontally, and at most @p z_radius Z levels above or below it.
+         * Dead monsters are ignored and not returned.
+         */
+        std::vector<shared_ptr_fast<monster>> find_in_radius( const tripoint &center, int radius,
+                                           int z_radius = 0 ) const;
         /**
          * Returns a temporary id of the given monster (which must exist in the tracker).
          * The id is valid until monsters are added or removed from the tracker.
@@ -94,6 +108,12 @@ class Creature_tracker
     private:
         std::vector<shared_ptr_fast<monster>> monsters_list;
         std::unordered_map<tripoint, shared_ptr_fast<monster>> monsters_by_location;
+        /** Same monsters as @ref monsters_by_location, bucketed by the submap they are in */
+        std::unordered_map<tripoint, std::vector<shared_ptr_fast<monster>>> monsters_by_submap;
+        /** Put the monster at the given location, in both location maps */
+        void set_location( const tripoint &pos, const shared_ptr_fast<monster> &critter );
+        /** Take the entry out of both location maps */
+        void erase_location( decltype( monsters_by_location )::iterator iter );
         /** Remove the monsters entry in @ref monsters_by_location */
         void remove_from_location_map( const monster &critter );
 };
@@ -107,12 +107,12 @@ static bool buffering_debugmsgs = true;
 /** Set to true when any error is logged. */
 static bool error_observed = false;
 
-/** If true, debug messages will be captured,
- * used to test debugmsg calls in the unit tests
+/** If true, debug messages will be captured instead of shown,
+ * used to test debugmsg calls in the unit tests and to collect them from worker threads
  */
-static bool capturing = false;
+static thread_local bool capturing = false;
 /** сaptured debug messages */
-static std::string captured;
+static thread_local std::string captured;
 
 
 #if defined(_WIN32) && defined(LIBBACKTRACE)
@@ -464,13 +464,14 @@ void realDebugmsg( const char *filename, const char *line, const char *funcname,
 
     if( capturing ) {
         captured += text;
+        return;
+    }
+
+    if( !rep_folder.test( filename, line, funcname, text ) ) {
+        *detail::realDebugLog( debug_level, DC::DebugMsg, filename, line, funcname ) << text;
+        rep_folder.set( filename, line, funcname, text );
     } else {
-        if( !rep_folder.test( filename, line, funcname, text ) ) {
-            *detail::realDebugLog( debug_level, DC::DebugMsg, filename, line, funcname ) << text;
-            rep_folder.set( filename, line, funcname, text );
-        } else {
-            rep_folder.increment_count();
-        }
+        rep_folder.increment_count();
     }
 
     if( test_mode ) {
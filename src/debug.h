@@ -201,8 +201,9 @@ bool debug_has_error_been_observed();
 void debug_reset_ignored_messages();
 
 /**
- * Capturing debug messages during func execution,
- * used to test debugmsg calls in the unit tests
+ * Capturing debug messages during func execution on the calling thread,
+ * used to test debugmsg calls in the unit tests.  Captured messages are
+ * neither logged nor shown.
  * @return std::string debugmsg
  */
 std::string capture_debugmsg_during( const std::function<void()> &func );
@@ -161,8 +161,15 @@ std::string read_entire_file( const std::string &path )
     if( !infile.is_open() ) {
         return "";
     }
-    std::string ret = std::string( std::istreambuf_iterator<char>( *infile ),
-                                   std::istreambuf_iterator<char>() );
+    // Read in one go instead of a character at a time.
+    infile->seekg( 0, std::ios::end );
+    const std::streamoff size = infile->tellg();
+    infile->seekg( 0, std::ios::beg );
+    std::string ret;
+    if( size > 0 ) {
+        ret.resize( size );
+        infile->read( ret.data(), size );
+    }
     if( infile.fail() ) {
         return "";
     }
@@ -240,6 +240,7 @@ static const efftype_id effect_sleep( "sleep" );
 static const efftype_id effect_stunned( "stunned" );
 static const efftype_id effect_tied( "tied" );
 
+static const bionic_id bio_alarm( "bio_alarm" );
 static const bionic_id bio_remote( "bio_remote" );
 static const bionic_id bio_probability_travel( "bio_probability_travel" );
 
@@ -1605,7 +1606,8 @@ bool game::do_turn()
     // reset player noise
     u.volume = 0;
 
-    // Finally, clear pathfinding cache
+    // Finally, hand long routes out to be found before next turn and clear pathfinding cache
+    Pathfinding::dispatch_route_requests();
     Pathfinding::clear_d_maps();
 
     return false;
@@ -2759,6 +2761,8 @@ bool game::save( bool quitting )
     world->start_save_tx();
 
     cata::run_on_game_save_hooks( *DynamicDataLoader::get_instance().lua );
+    // The unique specials in the master file must match the overmaps saved with it.
+    overmap_buffer.finish_generating_ahead( true );
     try {
         reset_save_ids( time( nullptr ), quitting );
         if( !save_factions_missions_npcs() ||
@@ -4156,17 +4160,17 @@ void game::monmove()
             m.creature_in_field( critter );
         }
 
-        const bionic_id bio_alarm( "bio_alarm" );
+        // Cheap per-critter checks first, so the bionic lookup only happens for nearby critters
         if( !critter.is_dead() &&
-            u.has_active_bionic( bio_alarm ) &&
-            u.get_power_level() >= bio_alarm->power_trigger &&
             rl_dist( u.pos(), critter.pos() ) <= 5 &&
-            !critter.is_hallucination() ) {
+            !critter.is_hallucination() &&
+            u.has_active_bionic( bio_alarm ) &&
+            u.get_power_level() >= bio_alarm->power_trigger ) {
             u.mod_power_level( -bio_alarm->power_trigger );
             add_msg( m_warning, _( "Your motion alarm goes off!" ) );
             cancel_activity_or_ignore_query( distraction_type::alert,
                                              _( "Your motion alarm goes off!" ) );
-            if( u.has_effect( efftype_id( "sleep" ) ) ) {
+            if( u.has_effect( effect_sleep ) ) {
                 u.wake_up();
             }
         }
@@ -10891,9 +10895,29 @@ point game::update_map( int &x, int &y )
     // Update what parts of the world map we can see
     update_overmap_seen();
 
+    prefetch_submaps_ahead( shift );
+    overmap_buffer.generate_ahead( u.global_omt_location(),
+                                   get_option<int>( "OVERMAP_GENERATE_AHEAD" ) );
+
     return shift;
 }
 
+void game::prefetch_submaps_ahead( point last_shift )
+{
+    point dir( sgn( last_shift.x ), sgn( last_shift.y ) );
+    int distance = 1;
+    const vehicle *veh = u.in_vehicle ? veh_pointer_or_null( m.veh_at( u.pos() ) ) : nullptr;
+    if( veh != nullptr && veh->velocity != 0 ) {
+        // Go by where the vehicle is heading rather than the last shift, which lags
+        // behind when turning, and look further ahead the faster it goes.
+        const units::angle heading = veh->velocity > 0 ? veh->move.dir() : veh->move.dir() + 180_degrees;
+        dir = point( std::lround( units::cos( heading ) ), std::lround( units::sin( heading ) ) );
+        const float submaps_per_turn = std::abs( veh->velocity ) / vehicles::vmiph_per_tile / SEEX;
+        distance = clamp( 1 + static_cast<int>( submaps_per_turn ), 1, 3 );
+    }
+    m.prefetch_submaps( dir, distance );
+}
+
 void game::update_overmap_seen()
 {
     const tripoint_abs_omt ompos = u.global_omt_location();
@@ -517,6 +517,8 @@ class game
         // Helper to make calling with a player pointer less verbose.
         point update_map( player &p );
         point update_map( int &x, int &y );
+        // Reads the submaps the player is heading towards ahead of time, see map::prefetch_submaps.
+        void prefetch_submaps_ahead( point last_shift );
         void update_overmap_seen(); // Update which overmap tiles we can see
 
         void process_artifact( item &it, player &p );
@@ -1,14 +1,18 @@
 #include "init.h"
 
+#include <atomic>
 #include <cassert>
 #include <cstddef>
 #include <exception>
 #include <fstream>
+#include <future>
 #include <iterator>
 #include <memory>
+#include <optional>
 #include <sstream> // for throwing errors
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "achievement.h"
@@ -466,6 +470,52 @@ void DynamicDataLoader::initialize()
 #endif
 }
 
+namespace
+{
+/** A data file as read and indexed by @ref index_json_file. */
+struct indexed_json_file {
+    std::string data;
+    /**
+     * Every object in the file, in order.  Empty if the file is not a valid object or
+     * list of objects, loading it the regular way reports the error then.
+     */
+    std::optional<std::vector<json_object_index>> objects;
+};
+} // namespace
+
+/**
+ * Read a data file and find all its top level objects.  Scanning the objects is most of
+ * the parsing and doesn't touch any game state, so this can run on any thread.
+ * Checks the file the same way @ref DynamicDataLoader::load_all_from_json does.
+ */
+static indexed_json_file index_json_file( const std::string &file )
+{
+    indexed_json_file ret;
+    ret.data = read_entire_file( file );
+    try {
+        JsonIn jsin( std::string_view( ret.data ), file );
+        std::vector<json_object_index> objects;
+        if( jsin.test_object() ) {
+            objects.push_back( JsonObject::index( jsin ) );
+            jsin.eat_whitespace();
+            if( jsin.good() ) {
+                return ret;
+            }
+        } else if( jsin.test_array() ) {
+            jsin.start_array();
+            while( !jsin.end_array() ) {
+                objects.push_back( JsonObject::index( jsin ) );
+            }
+        } else {
+            return ret;
+        }
+        ret.objects = std::move( objects );
+    } catch( const JsonError & ) {
+        // Reported when loading the file.
+    }
+    return ret;
+}
+
 void DynamicDataLoader::load_data_from_path( const std::string &path, const std::string &src,
         loading_ui &ui )
 {
@@ -486,22 +536,48 @@ void DynamicDataLoader::load_data_from_path( const std::string &path, const std:
             files.push_back( path );
         }
     }
+
+    // Read and index the files on worker threads, while they are loaded here in order.
+    std::vector<std::promise<indexed_json_file>> indexed( files.size() );
+    std::atomic<size_t> next_file = 0;
+    std::atomic<bool> stop = false;
+    const auto index_files = [&]() {
+        for( size_t i = next_file++; i < files.size() && !stop; i = next_file++ ) {
+            try {
+                indexed[i].set_value( index_json_file( files[i] ) );
+            } catch( ... ) {
+                indexed[i].set_exception( std::current_exception() );
+            }
+        }
+    };
+    const size_t num_workers = std::min<size_t>( files.size(),
+                               std::max( 1U, std::thread::hardware_concurrency() ) );
+    std::vector<std::future<void>> workers;
+    for( size_t i = 0; i < num_workers; i++ ) {
+        workers.push_back( std::async( std::launch::async, index_files ) );
+    }
+    // Workers still running when loading fails shouldn't bother with the rest.
+    on_out_of_scope stop_workers( [&]() {
+        stop = true;
+    } );
+
     // iterate over each file
-    for( auto &files_i : files ) {
-        const std::string &file = files_i;
-        // open the file as a stream
-        cata_ifstream infile = std::move( cata_ifstream().mode( cata_ios_mode::binary ).open( file ) );
-        // and stuff it into ram
-        std::istringstream iss(
-            std::string(
-                ( std::istreambuf_iterator<char>( *infile ) ),
-                std::istreambuf_iterator<char>()
-            )
-        );
+    for( size_t i = 0; i < files.size(); i++ ) {
+        const std::string &file = files[i];
+        indexed_json_file f = indexed[i].get_future().get();
         try {
             // parse it
-            JsonIn jsin( iss, file );
-            load_all_from_json( jsin, src, ui, path, file );
+            JsonIn jsin( std::string_view( f.data ), file );
+            if( f.objects ) {
+                for( json_object_index &index : *f.objects ) {
+                    JsonObject jo( jsin, std::move( index ) );
+                    load_object( jo, src, path, file );
+                    jo.finish();
+                }
+                inp_mngr.pump_events();
+            } else {
+                load_all_from_json( jsin, src, ui, path, file );
+            }
         } catch( const JsonError &err ) {
             throw std::runtime_error( err.what() );
         }
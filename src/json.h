@@ -9,6 +9,7 @@
 #include <set>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -83,10 +84,118 @@ struct number_sci_notation {
     int64_t exp = 0;
 };
 
+/**
+ * Where a JsonIn reads from: either a std::istream, or a contiguous buffer in memory
+ * that is scanned with plain pointers.  The latter skips the sentry and virtual calls
+ * std::istream makes for every character, which adds up when loading the game data.
+ *
+ * Only the part of the std::istream interface used by JsonIn is provided, and the
+ * buffer emulates the eof and fail states of a std::istream over the same data, so
+ * parsing and error locations are identical for both.
+ */
+class json_istream
+{
+    public:
+        explicit json_istream( std::istream &s ) : stream( &s ) {}
+        /** The buffer isn't copied and must outlive this. */
+        explicit json_istream( std::string_view buf )
+            : begin( buf.data() ), cur( buf.data() ), end( buf.data() + buf.size() ) {}
+
+        bool good() const {
+            return stream ? stream->good() : !eof_bit && !fail_bit;
+        }
+        bool eof() const {
+            return stream ? stream->eof() : eof_bit;
+        }
+        bool fail() const {
+            return stream ? stream->fail() : fail_bit;
+        }
+        void clear() {
+            if( stream ) {
+                stream->clear();
+            } else {
+                eof_bit = fail_bit = false;
+            }
+        }
+
+        int get() {
+            if( stream ) {
+                return stream->get();
+            }
+            if( !sentry() ) {
+                return EOF;
+            }
+            if( cur == end ) {
+                eof_bit = fail_bit = true;
+                return EOF;
+            }
+            return static_cast<unsigned char>( *cur++ );
+        }
+        bool get( char &ch ) {
+            if( stream ) {
+                return !!stream->get( ch );
+            }
+            const int c = get();
+            if( c != EOF ) {
+                ch = static_cast<char>( c );
+            }
+            return c != EOF;
+        }
+        int peek() {
+            if( stream ) {
+                return stream->peek();
+            }
+            if( !sentry() ) {
+                return EOF;
+            }
+            if( cur == end ) {
+                eof_bit = true;
+                return EOF;
+            }
+            return static_cast<unsigned char>( *cur );
+        }
+        void ignore() {
+            if( stream ) {
+                stream->ignore();
+            } else if( sentry() ) {
+                if( cur == end ) {
+                    eof_bit = true;
+                } else {
+                    ++cur;
+                }
+            }
+        }
+        void unget();
+
+        /** Like std::istream::get( char *, std::streamsize ), stops before a newline. */
+        bool get( char *s, int n );
+        bool read( char *s, int n );
+        int tellg();
+        void seekg( int pos );
+        void seekg( int off, std::ios_base::seekdir dir );
+
+    private:
+        std::istream *stream = nullptr;
+        const char *begin = nullptr;
+        const char *cur = nullptr;
+        const char *end = nullptr;
+        bool eof_bit = false;
+        bool fail_bit = false;
+
+        // What constructing a std::istream::sentry does to the stream state.
+        bool sentry() {
+            if( eof_bit || fail_bit ) {
+                fail_bit = true;
+                return false;
+            }
+            return true;
+        }
+};
+
 /* JsonIn
  * ======
  *
- * The JsonIn class provides a wrapper around a std::istream,
+ * The JsonIn class provides a wrapper around a std::istream, or a buffer in memory,
  * with methods for reading JSON data directly from the stream.
  *
  * JsonObject and JsonArray provide higher-level wrappers,
@@ -166,7 +275,7 @@ struct number_sci_notation {
 class JsonIn
 {
     private:
-        std::istream *stream;
+        json_istream stream;
         shared_ptr_fast<std::string> path;
         bool ate_separator = false;
 
@@ -175,13 +284,17 @@ class JsonIn
         void end_value();
 
     public:
-        JsonIn( std::istream &s ) : stream( &s ) {}
+        JsonIn( std::istream &s ) : stream( s ) {}
         JsonIn( std::istream &s, const std::string &path )
-            : stream( &s ), path( make_shared_fast<std::string>( path ) ) {}
+            : stream( s ), path( make_shared_fast<std::string>( path ) ) {}
         JsonIn( std::istream &s, const json_source_location &loc )
-            : stream( &s ), path( loc.path ) {
+            : stream( s ), path( loc.path ) {
             seek( loc.offset );
         }
+        /** Parse straight from @p buf, which must outlive this. */
+        explicit JsonIn( std::string_view buf ) : stream( buf ) {}
+        JsonIn( std::string_view buf, const std::string &path )
+            : stream( buf ), path( make_shared_fast<std::string>( path ) ) {}
         JsonIn( const JsonIn & ) = delete;
         JsonIn &operator=( const JsonIn & ) = delete;
 
@@ -829,6 +942,18 @@ class JsonOut
         }
 };
 
+/**
+ * Where the members of a JSON object are, which is all a JsonObject needs.
+ * Can be worked out ahead of time, e.g. on another thread with its own JsonIn
+ * reading the same data, see @ref JsonObject::index.
+ */
+struct json_object_index {
+    std::map<std::string, int> positions;
+    int start = 0;
+    int end_ = 0;
+    bool final_separator = false;
+};
+
 /* JsonObject
  * ==========
  *
@@ -924,7 +1049,14 @@ class JsonObject
 
     public:
         JsonObject( JsonIn &jsin );
+        /**
+         * Object at the start of @p index, without scanning it.  Leaves @p jsin after
+         * the object, like the other constructor.
+         */
+        JsonObject( JsonIn &jsin, json_object_index &&index );
         JsonObject() : start( 0 ), end_( 0 ), jsin( nullptr ) {}
+        /** Scan the object at the current position, leaving @p jsin after it. */
+        static json_object_index index( JsonIn &jsin );
         JsonObject( const JsonObject & ) = default;
         JsonObject( JsonObject && ) = default;
         JsonObject &operator=( const JsonObject & ) = default;
@@ -43,6 +43,10 @@ struct pathfinding_cache {
     bool dirty;
 
     pf_special special[MAPSIZE_X][MAPSIZE_Y];
+
+    // Revision of each submap's contents, from a counter shared by all maps that is bumped on every change.
+    // Lets caches that outlive `dirty` (hierarchical pathfinding) rebuild only the submaps that changed.
+    int submap_revision[MAPSIZE][MAPSIZE];
 };
 
 struct pathfinding_settings {
@@ -15,6 +15,7 @@
 #include "cata_utility.h"
 #include "character.h"
 #include "cuboid_rectangle.h"
+#include "debug.h"
 #include "field.h"
 #include "fragment_cloud.h" // IWYU pragma: keep
 #include "game.h"
@@ -29,6 +30,7 @@
 #include "monster.h"
 #include "mtype.h"
 #include "npc.h"
+#include "options.h"
 #include "player.h"
 #include "point.h"
 #include "profile.h"
@@ -84,8 +86,9 @@ struct transparency_exp_lookup {
 const transparency_exp_lookup<90> openair_transparency_lookup( LIGHT_TRANSPARENCY_OPEN_AIR );
 transparency_exp_lookup<90> weather_transparency_lookup( LIGHT_TRANSPARENCY_OPEN_AIR * 1.1 );
 
-void map::add_light_from_items( const tripoint &p, const item_stack::iterator &begin,
-                                const item_stack::iterator &end )
+void map::collect_light_from_items( std::vector<light_emitter> &emitters, const tripoint &p,
+                                    const item_stack::iterator &begin,
+                                    const item_stack::iterator &end )
 {
     for( auto itm_it = begin; itm_it != end; ++itm_it ) {
         float ilum = 0.0f; // brightness
@@ -93,16 +96,27 @@ void map::add_light_from_items( const tripoint &p, const item_stack::iterator &b
         units::angle idir = 0_degrees;   // otherwise, it's a light_arc pointed in this direction
         if( ( *itm_it )->getlight( ilum, iwidth, idir ) ) {
             if( iwidth > 0_degrees ) {
-                apply_light_arc( p, idir, ilum, iwidth );
+                emitters.push_back( { light_emitter::emitter_type::arc, p, ilum, idir, iwidth } );
             } else {
-                add_light_source( p, ilum );
+                emitters.push_back( { light_emitter::emitter_type::buffered, p, ilum } );
             }
         }
     }
 }
 
 // TODO: Consider making this just clear the cache and dynamically fill it in as is_transparent() is called
-bool map::build_transparency_cache( const int zlev )
+float map::update_weather_transparency()
+{
+    const float sight_penalty = get_weather().weather_id->sight_penalty;
+
+    if( sight_penalty != 1.0f &&
+        LIGHT_TRANSPARENCY_OPEN_AIR * sight_penalty != weather_transparency_lookup.transparency ) {
+        weather_transparency_lookup.reset( LIGHT_TRANSPARENCY_OPEN_AIR * sight_penalty );
+    }
+    return sight_penalty;
+}
+
+bool map::build_transparency_cache( const int zlev, const float sight_penalty )
 {
     auto &map_cache = get_cache( zlev );
     auto &transparency_cache = map_cache.transparency_cache;
@@ -123,13 +137,6 @@ bool map::build_transparency_cache( const int zlev )
                                    static_cast<float>( LIGHT_TRANSPARENCY_OPEN_AIR ) );
     }
 
-    const float sight_penalty = get_weather().weather_id->sight_penalty;
-
-    if( sight_penalty != 1.0f &&
-        LIGHT_TRANSPARENCY_OPEN_AIR * sight_penalty != weather_transparency_lookup.transparency ) {
-        weather_transparency_lookup.reset( LIGHT_TRANSPARENCY_OPEN_AIR * sight_penalty );
-    }
-
     // Traverse the submaps in order
     for( int smx = 0; smx < my_MAPSIZE; ++smx ) {
         for( int smy = 0; smy < my_MAPSIZE; ++smy ) {
@@ -477,6 +484,10 @@ void map::generate_lightmap( const int zlev )
         apply_character_light( guy );
     }
 
+    // Collect all the emitters before casting any light, so that the previous lightmap
+    // can be reused when neither they nor anything the light passes through has changed.
+    std::vector<light_emitter> tile_emitters;
+    std::vector<light_emitter> other_emitters;
     std::vector<std::pair<tripoint, float>> lm_override;
     // Traverse the submaps in order
     for( int smx = 0; smx < my_MAPSIZE; ++smx ) {
@@ -488,47 +499,32 @@ void map::generate_lightmap( const int zlev )
                     const int x = sx + smx * SEEX;
                     const int y = sy + smy * SEEY;
                     const tripoint p( x, y, zlev );
-                    // Project light into any openings into buildings.
-                    if( !outside_cache[p.x][p.y] || ( !top_floor && prev_floor_cache[p.x][p.y] ) ) {
-                        // Apply light sources for external/internal divide
-                        for( int i = 0; i < 4; ++i ) {
-                            point neighbour = p.xy() + point( dir_x[i], dir_y[i] );
-                            if( lightmap_boundaries.contains( neighbour )
-                                && outside_cache[neighbour.x][neighbour.y] &&
-                                ( top_floor || !prev_floor_cache[neighbour.x][neighbour.y] )
-                              ) {
-                                const float source_light =
-                                    std::min( natural_light, lm[neighbour.x][neighbour.y].max() );
-                                if( light_transparency( p ) > LIGHT_TRANSPARENCY_SOLID ) {
-                                    update_light_quadrants( lm[p.x][p.y], source_light, quadrant::default_ );
-                                    apply_directional_light( p, dir_d[i], source_light );
-                                } else {
-                                    update_light_quadrants( lm[p.x][p.y], source_light, dir_quadrants[i][0] );
-                                    update_light_quadrants( lm[p.x][p.y], source_light, dir_quadrants[i][1] );
-                                }
-                            }
-                        }
-                    }
 
                     if( cur_submap->get_lum( { sx, sy } ) && has_items( p ) ) {
                         auto items = i_at( p );
-                        add_light_from_items( p, items.begin(), items.end() );
+                        collect_light_from_items( tile_emitters, p, items.begin(), items.end() );
                     }
 
                     const ter_id terrain = cur_submap->get_ter( { sx, sy } );
                     if( terrain->light_emitted > 0 ) {
-                        add_light_source( p, terrain->light_emitted );
+                        tile_emitters.push_back( { light_emitter::emitter_type::buffered, p,
+                                                   static_cast<float>( terrain->light_emitted )
+                                                 } );
                     }
                     const furn_id furniture = cur_submap->get_furn( {sx, sy } );
                     if( furniture->light_emitted > 0 ) {
-                        add_light_source( p, furniture->light_emitted );
+                        tile_emitters.push_back( { light_emitter::emitter_type::buffered, p,
+                                                   static_cast<float>( furniture->light_emitted )
+                                                 } );
                     }
 
                     for( auto &fld : cur_submap->get_field( { sx, sy } ) ) {
                         const field_entry *cur = &fld.second;
                         const int light_emitted = cur->light_emitted();
                         if( light_emitted > 0 ) {
-                            add_light_source( p, light_emitted );
+                            tile_emitters.push_back( { light_emitter::emitter_type::buffered, p,
+                                                       static_cast<float>( light_emitted )
+                                                     } );
                         }
                         const float light_override = cur->local_light_override();
                         if( light_override >= 0.0 ) {
@@ -547,13 +543,15 @@ void map::generate_lightmap( const int zlev )
         const tripoint &mp = critter.pos();
         if( inbounds( mp ) ) {
             if( critter.has_effect( effect_onfire ) ) {
-                apply_light_source( mp, 8 );
+                other_emitters.push_back( { light_emitter::emitter_type::immediate, mp, 8.0f } );
             }
             // TODO: [lightmap] Attach natural light brightness to creatures
             // TODO: [lightmap] Allow creatures to have light attacks (i.e.: eyebot)
             // TODO: [lightmap] Allow creatures to have facing and arc lights
             if( critter.type->luminance > 0 ) {
-                apply_light_source( mp, critter.type->luminance );
+                other_emitters.push_back( { light_emitter::emitter_type::immediate, mp,
+                                            critter.type->luminance
+                                          } );
             }
         }
     }
@@ -577,6 +575,13 @@ void map::generate_lightmap( const int zlev )
             }
         }
 
+        // Add a little surrounding light around directed lights
+        const auto add_surrounding_light = [&other_emitters]( const tripoint & src ) {
+            other_emitters.push_back( { light_emitter::emitter_type::buffered, src,
+                                        static_cast<float>( M_SQRT2 )
+                                      } );
+        };
+
         for( const auto pt : lights ) {
             const auto &vp = pt->info();
             tripoint src = v->global_part_pos3( *pt );
@@ -587,21 +592,26 @@ void map::generate_lightmap( const int zlev )
 
             if( vp.has_flag( VPFLAG_CONE_LIGHT ) ) {
                 if( veh_luminance > lit_level::LIT ) {
-                    add_light_source( src, M_SQRT2 ); // Add a little surrounding light
-                    apply_light_arc( src, v->face.dir() + pt->direction, veh_luminance,
-                                     45_degrees );
+                    add_surrounding_light( src );
+                    other_emitters.push_back( { light_emitter::emitter_type::arc, src, veh_luminance,
+                                                v->face.dir() + pt->direction, 45_degrees
+                                              } );
                 }
 
             } else if( vp.has_flag( VPFLAG_WIDE_CONE_LIGHT ) ) {
                 if( veh_luminance > lit_level::LIT ) {
-                    add_light_source( src, M_SQRT2 ); // Add a little surrounding light
-                    apply_light_arc( src, v->face.dir() + pt->direction, veh_luminance,
-                                     90_degrees );
+                    add_surrounding_light( src );
+                    other_emitters.push_back( { light_emitter::emitter_type::arc, src, veh_luminance,
+                                                v->face.dir() + pt->direction, 90_degrees
+                                              } );
                 }
 
             } else if( vp.has_flag( VPFLAG_HALF_CIRCLE_LIGHT ) ) {
-                add_light_source( src, M_SQRT2 ); // Add a little surrounding light
-                apply_light_arc( src, v->face.dir() + pt->direction, vp.bonus, 180_degrees );
+                add_surrounding_light( src );
+                other_emitters.push_back( { light_emitter::emitter_type::arc, src,
+                                            static_cast<float>( vp.bonus ),
+                                            v->face.dir() + pt->direction, 180_degrees
+                                          } );
 
             } else if( vp.has_flag( VPFLAG_CIRCLE_LIGHT ) ) {
                 const bool odd_turn = calendar::once_every( 2_turns );
@@ -609,11 +619,15 @@ void map::generate_lightmap( const int zlev )
                     ( !odd_turn && vp.has_flag( VPFLAG_EVENTURN ) ) ||
                     ( !( vp.has_flag( VPFLAG_EVENTURN ) || vp.has_flag( VPFLAG_ODDTURN ) ) ) ) {
 
-                    add_light_source( src, vp.bonus );
+                    other_emitters.push_back( { light_emitter::emitter_type::buffered, src,
+                                                static_cast<float>( vp.bonus )
+                                              } );
                 }
 
             } else {
-                add_light_source( src, vp.bonus );
+                other_emitters.push_back( { light_emitter::emitter_type::buffered, src,
+                                            static_cast<float>( vp.bonus )
+                                          } );
             }
         }
 
@@ -624,12 +638,97 @@ void map::generate_lightmap( const int zlev )
                 continue;
             }
             if( vp.has_feature( VPFLAG_CARGO ) && !vp.has_feature( "COVERED" ) ) {
-                add_light_from_items( pp, v->get_items( static_cast<int>( p ) ).begin(),
-                                      v->get_items( static_cast<int>( p ) ).end() );
+                collect_light_from_items( other_emitters, pp,
+                                          v->get_items( static_cast<int>( p ) ).begin(),
+                                          v->get_items( static_cast<int>( p ) ).end() );
             }
         }
     }
 
+    if( !last_lightmap ) {
+        last_lightmap = std::make_unique<lightmap_memo>();
+    }
+    lightmap_memo &memo = *last_lightmap;
+    const bool unchanged = memo.valid && memo.zlev == zlev &&
+                           memo.natural_light == natural_light && memo.trigdist == trigdist &&
+                           std::memcmp( memo.lm_before, lm, sizeof( lm ) ) == 0 &&
+                           std::memcmp( memo.sm_before, sm, sizeof( sm ) ) == 0 &&
+                           std::memcmp( memo.transparency_cache, map_cache.transparency_cache,
+                                        sizeof( memo.transparency_cache ) ) == 0 &&
+                           std::memcmp( memo.vehicle_obscured_cache, map_cache.vehicle_obscured_cache,
+                                        sizeof( memo.vehicle_obscured_cache ) ) == 0 &&
+                           std::memcmp( memo.outside_cache, outside_cache, sizeof( outside_cache ) ) == 0 &&
+                           std::memcmp( memo.floor_cache_above, prev_floor_cache,
+                                        sizeof( prev_floor_cache ) ) == 0 &&
+                           memo.tile_emitters == tile_emitters && memo.other_emitters == other_emitters &&
+                           memo.lm_override == lm_override;
+    const bool verify = unchanged && get_option<bool>( "VERIFY_LIGHTMAP_CACHE" );
+    if( unchanged && !verify ) {
+        std::memcpy( lm, memo.lm, sizeof( lm ) );
+        std::memcpy( sm, memo.sm, sizeof( sm ) );
+        return;
+    }
+    if( !unchanged ) {
+        memo.valid = true;
+        memo.zlev = zlev;
+        memo.natural_light = natural_light;
+        memo.trigdist = trigdist;
+        std::memcpy( memo.lm_before, lm, sizeof( lm ) );
+        std::memcpy( memo.sm_before, sm, sizeof( sm ) );
+        std::memcpy( memo.transparency_cache, map_cache.transparency_cache,
+                     sizeof( memo.transparency_cache ) );
+        std::memcpy( memo.vehicle_obscured_cache, map_cache.vehicle_obscured_cache,
+                     sizeof( memo.vehicle_obscured_cache ) );
+        std::memcpy( memo.outside_cache, outside_cache, sizeof( outside_cache ) );
+        std::memcpy( memo.floor_cache_above, prev_floor_cache, sizeof( prev_floor_cache ) );
+        memo.tile_emitters = tile_emitters;
+        memo.other_emitters = other_emitters;
+        memo.lm_override = lm_override;
+    }
+
+    auto tile_emitter = tile_emitters.cbegin();
+    for( int smx = 0; smx < my_MAPSIZE; ++smx ) {
+        for( int smy = 0; smy < my_MAPSIZE; ++smy ) {
+            for( int sx = 0; sx < SEEX; ++sx ) {
+                for( int sy = 0; sy < SEEY; ++sy ) {
+                    const int x = sx + smx * SEEX;
+                    const int y = sy + smy * SEEY;
+                    const tripoint p( x, y, zlev );
+                    // Project light into any openings into buildings.
+                    if( !outside_cache[p.x][p.y] || ( !top_floor && prev_floor_cache[p.x][p.y] ) ) {
+                        // Apply light sources for external/internal divide
+                        for( int i = 0; i < 4; ++i ) {
+                            point neighbour = p.xy() + point( dir_x[i], dir_y[i] );
+                            if( lightmap_boundaries.contains( neighbour )
+                                && outside_cache[neighbour.x][neighbour.y] &&
+                                ( top_floor || !prev_floor_cache[neighbour.x][neighbour.y] )
+                              ) {
+                                const float source_light =
+                                    std::min( natural_light, lm[neighbour.x][neighbour.y].max() );
+                                if( light_transparency( p ) > LIGHT_TRANSPARENCY_SOLID ) {
+                                    update_light_quadrants( lm[p.x][p.y], source_light, quadrant::default_ );
+                                    apply_directional_light( p, dir_d[i], source_light );
+                                } else {
+                                    update_light_quadrants( lm[p.x][p.y], source_light, dir_quadrants[i][0] );
+                                    update_light_quadrants( lm[p.x][p.y], source_light, dir_quadrants[i][1] );
+                                }
+                            }
+                        }
+                    }
+
+                    // Emitters on this tile, in the order they were collected
+                    for( ; tile_emitter != tile_emitters.cend() && tile_emitter->p == p; ++tile_emitter ) {
+                        apply_light_emitter( *tile_emitter );
+                    }
+                }
+            }
+        }
+    }
+
+    for( const light_emitter &emitter : other_emitters ) {
+        apply_light_emitter( emitter );
+    }
+
     /* Now that we have position and intensity of all bulk light sources, apply_ them
       This may seem like extra work, but take a 12x12 raging inferno:
         unbuffered: (12^2)*(160*4) = apply_light_ray x 92160
@@ -645,6 +744,28 @@ void map::generate_lightmap( const int zlev )
     for( const std::pair<tripoint, float> &elem : lm_override ) {
         lm[elem.first.x][elem.first.y].fill( elem.second );
     }
+
+    if( verify && ( std::memcmp( memo.lm, lm, sizeof( lm ) ) != 0 ||
+                    std::memcmp( memo.sm, sm, sizeof( sm ) ) != 0 ) ) {
+        debugmsg( "Cached lightmap for z-level %d differs from a full rebuild", zlev );
+    }
+    std::memcpy( memo.lm, lm, sizeof( lm ) );
+    std::memcpy( memo.sm, sm, sizeof( sm ) );
+}
+
+void map::apply_light_emitter( const light_emitter &emitter )
+{
+    switch( emitter.type ) {
+        case light_emitter::emitter_type::buffered:
+            add_light_source( emitter.p, emitter.luminance );
+            break;
+        case light_emitter::emitter_type::immediate:
+            apply_light_source( emitter.p, emitter.luminance );
+            break;
+        case light_emitter::emitter_type::arc:
+            apply_light_arc( emitter.p, emitter.direction, emitter.luminance, emitter.width );
+            break;
+    }
 }
 
 void map::add_light_source( const tripoint &p, float luminance )
@@ -1190,6 +1311,20 @@ static inline bool eq_nullptr_gcc_hack( const void *check )
     return check == nullptr;
 }
 
+// Narrows [lo, hi] so that origin + step * x stays within [0, size) for every x in it.
+template<int step>
+static inline void clip_row_to_cache( const int origin, const int size, int &lo, int &hi )
+{
+    static_assert( step == 1 || step == -1, "rows advance one tile at a time" );
+    if constexpr( step > 0 ) {
+        lo = std::max( lo, -origin );
+        hi = std::min( hi, size - 1 - origin );
+    } else {
+        lo = std::max( lo, origin - size + 1 );
+        hi = std::min( hi, origin );
+    }
+}
+
 template<int xx, int xy, int yx, int yy, typename T, typename Out,
          T( *calc )( const T &, const T &, const int & ),
          bool( *check )( const T &, const T & ),
@@ -1258,16 +1393,26 @@ void castLight( Out( &output_cache )[MAPSIZE_X][MAPSIZE_Y],
         int x_limit = std::floor( std::min( 0.0f,
                                             ( ( -distance + 0.5f ) * end ) - 0.5f ) ) + 1;
 
+        // Clip the row to the cache up front instead of bounds checking every tile.
+        // Only one of the coordinates changes along a row, the other is fixed by delta.y.
+        const point row_origin( offset.x + delta.y * xy, offset.y + delta.y * yy );
+        if constexpr( xx != 0 ) {
+            if( row_origin.y < 0 || row_origin.y >= MAPSIZE_Y ) {
+                x_limit = delta.x - 1;
+            } else {
+                clip_row_to_cache<xx>( row_origin.x, MAPSIZE_X, delta.x, x_limit );
+            }
+        } else {
+            if( row_origin.x < 0 || row_origin.x >= MAPSIZE_X ) {
+                x_limit = delta.x - 1;
+            } else {
+                clip_row_to_cache<yx>( row_origin.y, MAPSIZE_Y, delta.x, x_limit );
+            }
+        }
+
         int last_dist = -1;
         for( ; delta.x <= x_limit; delta.x++ ) {
-            point current( offset.x + delta.x * xx + delta.y * xy, offset.y + delta.x * yx + delta.y * yy );
-
-            if( !( current.x >= 0 && current.y >= 0 && current.x < MAPSIZE_X &&
-                   current.y < MAPSIZE_Y ) /* || start < leadingEdge */ ) {
-                continue;
-            } /*else if( end > trailingEdge ) {
-                break;
-            }*/
+            const point current( row_origin.x + delta.x * xx, row_origin.y + delta.x * yx );
 
             if( check_blocked( current ) ) {
                 continue;
@@ -6,10 +6,12 @@
 #include <climits>
 #include <cstdlib>
 #include <cstring>
+#include <future>
 #include <limits>
 #include <optional>
 #include <ostream>
 #include <queue>
+#include <thread>
 #include <type_traits>
 #include <unordered_map>
 
@@ -1519,7 +1521,7 @@ void map::furn_set( const tripoint &p, const furn_id &new_furniture,
     set_memory_seen_cache_dirty( p );
 
     // TODO: Limit to changes that affect move cost, traps and stairs
-    set_pathfinding_cache_dirty( p.z );
+    set_pathfinding_cache_dirty( p );
 
     // Make sure the furniture falls if it needs to
     support_dirty( p );
@@ -1854,7 +1856,7 @@ bool map::ter_set( const tripoint &p, const ter_id &new_terrain )
     set_memory_seen_cache_dirty( p );
 
     // TODO: Limit to changes that affect move cost, traps and stairs
-    set_pathfinding_cache_dirty( p.z );
+    set_pathfinding_cache_dirty( p );
 
     tripoint above( p.xy(), p.z + 1 );
     // Make sure that if we supported something and no longer do so, it falls down
@@ -5754,7 +5756,7 @@ bool map::add_field( const tripoint &p, const field_type_id &type_id, int intens
     }
 
     if( fd_type.is_dangerous() ) {
-        set_pathfinding_cache_dirty( p.z );
+        set_pathfinding_cache_dirty( p );
     }
 
     // Ensure blood type fields don't hang in the air
@@ -5786,7 +5788,7 @@ void map::remove_field( const tripoint &p, const field_type_id &field_to_remove
             set_seen_cache_dirty( p );
         }
         if( fdata.is_dangerous() ) {
-            set_pathfinding_cache_dirty( p.z );
+            set_pathfinding_cache_dirty( p );
         }
     }
 }
@@ -6913,6 +6915,27 @@ void map::load( const tripoint_abs_sm &w, const bool update_vehicle, const bool
     load( w.raw(), update_vehicle, pump_events );
 }
 
+void map::prefetch_submaps( point dir, int distance )
+{
+    if( dir == point_zero || distance <= 0 ) {
+        return;
+    }
+    const tripoint abs = get_abs_sub();
+    // Submaps beyond the edge of the map, the corners included when moving diagonally.
+    for( int k = 1; k <= distance; k++ ) {
+        for( int i = -distance; i < my_MAPSIZE + distance; i++ ) {
+            if( dir.x != 0 ) {
+                const int x = dir.x > 0 ? my_MAPSIZE - 1 + k : -k;
+                MAPBUFFER.prefetch_submap( abs + point( x, i ) );
+            }
+            if( dir.y != 0 ) {
+                const int y = dir.y > 0 ? my_MAPSIZE - 1 + k : -k;
+                MAPBUFFER.prefetch_submap( abs + point( i, y ) );
+            }
+        }
+    }
+}
+
 void map::shift_traps( const tripoint &shift )
 {
     // Offset needs to have sign opposite to shift direction
@@ -8377,6 +8400,16 @@ void map::build_obstacle_cache( const tripoint &start, const tripoint &end,
 }
 
 bool map::build_floor_cache( const int zlev )
+{
+    std::vector<std::string> errors;
+    const bool rebuilt = build_floor_cache( zlev, errors );
+    for( const std::string &error : errors ) {
+        debugmsg( "%s", error );
+    }
+    return rebuilt;
+}
+
+bool map::build_floor_cache( const int zlev, std::vector<std::string> &errors )
 {
     auto &ch = get_cache( zlev );
     if( !ch.floor_cache_dirty ) {
@@ -8394,12 +8427,13 @@ bool map::build_floor_cache( const int zlev )
             const submap *below_submap = !lowest_z_lev ? get_submap_at_grid( { smx, smy, zlev - 1 } ) : nullptr;
 
             if( cur_submap == nullptr ) {
-                debugmsg( "Tried to build floor cache at (%d,%d,%d) but the submap is not loaded", smx, smy, zlev );
+                errors.push_back( string_format( "Tried to build floor cache at (%d,%d,%d) but the "
+                                                 "submap is not loaded", smx, smy, zlev ) );
                 continue;
             }
             if( !lowest_z_lev && below_submap == nullptr ) {
-                debugmsg( "Tried to build floor cache at (%d,%d,%d) but the submap is not loaded", smx, smy,
-                          zlev - 1 );
+                errors.push_back( string_format( "Tried to build floor cache at (%d,%d,%d) but the "
+                                                 "submap is not loaded", smx, smy, zlev - 1 ) );
                 continue;
             }
 
@@ -8597,14 +8631,57 @@ void map::build_map_cache( const int zlev, bool skip_lightmap )
     ZoneScoped;
     const int minz = zlevels ? -OVERMAP_DEPTH : zlev;
     const int maxz = zlevels ? OVERMAP_HEIGHT : zlev;
+    const float sight_penalty = update_weather_transparency();
+
+    // Outside, transparency and floor caches only read submaps and write their own level,
+    // so the levels that need rebuilding are split between worker threads.
+    std::vector<int> dirty_levels;
+    // Levels needing more than a few patched submaps; a turn without at least two of
+    // those isn't worth starting threads for.
+    size_t full_rebuilds = 0;
+    for( int z = minz; z <= maxz; z++ ) {
+        const level_cache &ch = get_cache( z );
+        if( ch.outside_cache_dirty || ch.transparency_cache_dirty.any() || ch.floor_cache_dirty ) {
+            dirty_levels.push_back( z );
+        }
+        if( ch.outside_cache_dirty || ch.transparency_cache_dirty.all() || ch.floor_cache_dirty ) {
+            full_rebuilds++;
+        }
+    }
+    std::array<bool, OVERMAP_LAYERS> floor_cache_rebuilt = {};
+    // Workers must not open debug messages, so those are reported after joining.
+    std::array<std::vector<std::string>, OVERMAP_LAYERS> floor_cache_errors;
+    const auto build_levels = [&]( const size_t first, const size_t stride ) {
+        for( size_t i = first; i < dirty_levels.size(); i += stride ) {
+            const int z = dirty_levels[i];
+            build_outside_cache( z );
+            build_transparency_cache( z, sight_penalty );
+            floor_cache_rebuilt[z + OVERMAP_DEPTH] = build_floor_cache( z,
+                    floor_cache_errors[z + OVERMAP_DEPTH] );
+        }
+    };
+    const size_t num_workers = full_rebuilds < 2 ? 1 : std::min<size_t>( dirty_levels.size(),
+                               std::max( 1U, std::thread::hardware_concurrency() ) );
+    std::vector<std::future<void>> workers;
+    for( size_t i = 1; i < num_workers; i++ ) {
+        workers.push_back( std::async( std::launch::async, build_levels, i, num_workers ) );
+    }
+    build_levels( 0, num_workers );
+    for( std::future<void> &worker : workers ) {
+        worker.get();
+    }
+    for( const std::vector<std::string> &errors : floor_cache_errors ) {
+        for( const std::string &error : errors ) {
+            debugmsg( "%s", error );
+        }
+    }
+
     bool seen_cache_dirty = false;
     for( int z = minz; z <= maxz; z++ ) {
         // trigger FOV recalculation only when there is a change on the player's level or if fov_3d is enabled
         const bool affects_seen_cache =  z == zlev || fov_3d;
-        build_outside_cache( z );
-        build_transparency_cache( z );
         update_suspension_cache( z );
-        seen_cache_dirty |= ( build_floor_cache( z ) && affects_seen_cache );
+        seen_cache_dirty |= ( floor_cache_rebuilt[z + OVERMAP_DEPTH] && affects_seen_cache );
         seen_cache_dirty |= get_cache( z ).seen_cache_dirty && affects_seen_cache;
         diagonal_blocks fill = {false, false};
         std::uninitialized_fill_n( &( get_cache( z ).vehicle_obscured_cache[0][0] ), MAPSIZE_X * MAPSIZE_Y,
@@ -9183,9 +9260,13 @@ level_cache::level_cache()
     std::fill_n( &veh_exists_at[0][0], map_dimensions, false );
 }
 
+// Never reused, so revisions from different maps can't be mistaken for each other
+static int last_pathfinding_revision = 0;
+
 pathfinding_cache::pathfinding_cache()
 {
     dirty = true;
+    std::fill_n( &submap_revision[0][0], MAPSIZE * MAPSIZE, ++last_pathfinding_revision );
 }
 
 
@@ -9198,8 +9279,28 @@ pathfinding_cache &map::get_pathfinding_cache( int zlev ) const
 void map::set_pathfinding_cache_dirty( const int zlev )
 {
     if( inbounds_z( zlev ) ) {
-        get_pathfinding_cache( zlev ).dirty = true;
+        pathfinding_cache &cache = get_pathfinding_cache( zlev );
+        cache.dirty = true;
+        std::fill_n( &cache.submap_revision[0][0], MAPSIZE * MAPSIZE, ++last_pathfinding_revision );
+    }
+}
+
+void map::set_pathfinding_cache_dirty( const tripoint &p )
+{
+    if( inbounds( p ) ) {
+        const tripoint smp = ms_to_sm_copy( p );
+        pathfinding_cache &cache = get_pathfinding_cache( smp.z );
+        cache.dirty = true;
+        cache.submap_revision[smp.x][smp.y] = ++last_pathfinding_revision;
+    }
+}
+
+int map::get_pathfinding_revision( const tripoint &grid ) const
+{
+    if( !inbounds_z( grid.z ) ) {
+        return 0;
     }
+    return get_pathfinding_cache( grid.z ).submap_revision[grid.x][grid.y];
 }
 
 bool map::check_seen_cache( const tripoint &p ) const
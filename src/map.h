@@ -355,6 +355,60 @@ struct level_cache {
 
 };
 
+/**
+ * A light emitter found by @ref map::generate_lightmap before any light is cast.
+ */
+struct light_emitter {
+    enum class emitter_type : int {
+        // Deferred to the end of lightmap generation, see map::add_light_source
+        buffered,
+        // Cast right away, see map::apply_light_source
+        immediate,
+        // Cast right away, see map::apply_light_arc
+        arc,
+    };
+
+    emitter_type type;
+    tripoint p;
+    float luminance;
+    units::angle direction = 0_degrees;
+    units::angle width = 0_degrees;
+
+    bool operator==( const light_emitter & ) const = default;
+};
+
+/**
+ * Inputs and result of the last lightmap generation.
+ *
+ * If nothing that light is emitted by or cast through has changed since, the cached
+ * lightmap is reused instead of casting all the light again. See @ref map::generate_lightmap.
+ */
+struct lightmap_memo {
+    bool valid = false;
+    int zlev = 0;
+    float natural_light = 0.0f;
+    bool trigdist = false;
+
+    // Sunlight and character light, which are applied before the emitters are collected
+    four_quadrants lm_before[MAPSIZE_X][MAPSIZE_Y];
+    float sm_before[MAPSIZE_X][MAPSIZE_Y];
+
+    float transparency_cache[MAPSIZE_X][MAPSIZE_Y];
+    diagonal_blocks vehicle_obscured_cache[MAPSIZE_X][MAPSIZE_Y];
+    bool outside_cache[MAPSIZE_X][MAPSIZE_Y];
+    bool floor_cache_above[MAPSIZE_X][MAPSIZE_Y];
+
+    // Emitters on the map tiles, in the order the tiles were traversed
+    std::vector<light_emitter> tile_emitters;
+    // Emitters attached to monsters and vehicles
+    std::vector<light_emitter> other_emitters;
+    std::vector<std::pair<tripoint, float>> lm_override;
+
+    // The resulting lightmap
+    four_quadrants lm[MAPSIZE_X][MAPSIZE_Y];
+    float sm[MAPSIZE_X][MAPSIZE_Y];
+};
+
 /**
  * Manage and cache data about a part of the map.
  *
@@ -420,8 +474,17 @@ class map
         void set_suspension_cache_dirty( const int zlev );
 
         void set_pathfinding_cache_dirty( int zlev );
+        // preferred over map::set_pathfinding_cache_dirty( const int zlev ), as it leaves
+        // the other submaps' revisions alone
+        void set_pathfinding_cache_dirty( const tripoint &p );
         /*@}*/
 
+        /**
+         * Revision of the contents of submap @p grid (in grid coordinates) that matter for
+         * pathfinding.  Changes whenever the pathfinding cache is dirtied for the submap.
+         */
+        int get_pathfinding_revision( const tripoint &grid ) const;
+
         void set_memory_seen_cache_dirty( const tripoint &p );
 
         void invalidate_map_cache( const int zlev );
@@ -513,6 +576,12 @@ class map
          * Note: the map must have been loaded before this can be called.
          */
         void shift( point s );
+        /**
+         * Start reading the submaps that a shift along @p dir would bring in from disk
+         * on a background thread, up to @p distance submaps beyond the edge of the map.
+         * Only the current z-level is read ahead.
+         */
+        void prefetch_submaps( point dir, int distance );
         /**
          * Moves the map vertically to (not by!) newz.
          * Does not actually shift anything, only forces cache updates.
@@ -533,7 +602,8 @@ class map
         std::pair<tripoint, maptile> maptile_has_bounds( const tripoint &p, bool bounds_checked );
         std::array<std::pair<tripoint, maptile>, 8> get_neighbors( const tripoint &p );
         void spread_gas( field_entry &cur, const tripoint &p, int percent_spread,
-                         const time_duration &outdoor_age_speedup, scent_block &sblk );
+                         const time_duration &outdoor_age_speedup, scent_block &sblk,
+                         const oter_id &cur_om_ter );
         void create_hot_air( const tripoint &p, int intensity );
         bool gas_can_spread_to( field_entry &cur, const tripoint &src, const tripoint &dst );
         void gas_spread_to( field_entry &cur, maptile &dst, const tripoint &p );
@@ -1786,9 +1856,12 @@ class map
         void draw_slimepit( mapgendata &dat );
         void draw_connections( const mapgendata &dat );
 
+        // Refreshes the weather fast path for shadowcasting and returns the weather's sight penalty.
+        float update_weather_transparency();
         // Builds a transparency cache and returns true if the cache was invalidated.
         // Used to determine if seen cache should be rebuilt.
-        bool build_transparency_cache( int zlev );
+        // Only touches the cache of zlev, so different levels may be built concurrently.
+        bool build_transparency_cache( int zlev, float sight_penalty );
         bool build_vision_transparency_cache( const Character &player );
         // fills lm with sunlight. pzlev is current player's zlevel
         void build_sunlight_cache( int pzlev );
@@ -1797,6 +1870,9 @@ class map
         // Builds a floor cache and returns true if the cache was invalidated.
         // Used to determine if seen cache should be rebuilt.
         bool build_floor_cache( int zlev );
+        // Same, but problems are appended to errors instead of being reported,
+        // so it can run off the main thread.
+        bool build_floor_cache( int zlev, std::vector<std::string> &errors );
         // We want this visible in `game`, because we want it built earlier in the turn than the rest
         void build_floor_caches();
         // Checks all suspended tiles on a z level and adds those that are invalid to the support_dirty_cache */
@@ -1919,8 +1995,10 @@ class map
                               units::angle wideangle = 30_degrees );
         void apply_light_ray( bool lit[MAPSIZE_X][MAPSIZE_Y],
                               const tripoint &s, const tripoint &e, float luminance );
-        void add_light_from_items( const tripoint &p, const item_stack::iterator &begin,
-                                   const item_stack::iterator &end );
+        void collect_light_from_items( std::vector<light_emitter> &emitters, const tripoint &p,
+                                       const item_stack::iterator &begin,
+                                       const item_stack::iterator &end );
+        void apply_light_emitter( const light_emitter &emitter );
         std::unique_ptr<vehicle> add_vehicle_to_map( std::unique_ptr<vehicle> veh, bool merge_wrecks );
 
         // Internal methods used to bash just the selected features
@@ -1990,6 +2068,10 @@ class map
         std::array< std::unique_ptr<level_cache>, OVERMAP_LAYERS > caches;
 
         mutable std::array< std::unique_ptr<pathfinding_cache>, OVERMAP_LAYERS > pathfinding_caches;
+        /**
+         * Last generated lightmap, allocated on first use.
+         */
+        std::unique_ptr<lightmap_memo> last_lightmap;
         /**
          * Set of submaps that contain active items in absolute coordinates.
          */
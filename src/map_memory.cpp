@@ -10,7 +10,7 @@
 #include "translations.h"
 #include "map.h"
 #include "world.h"
-const memorized_terrain_tile mm_submap::default_tile { "", 0, 0 };
+const memorized_terrain_tile mm_submap::default_tile { memorized_tile_id(), 0, 0 };
 const int mm_submap::default_symbol = 0;
 
 #define MM_SIZE (MAPSIZE * 2)
@@ -30,6 +30,38 @@ struct reg_coord_pair {
     }
 };
 
+namespace
+{
+struct tile_id_table {
+    std::vector<std::string> strings = { std::string() };
+    std::unordered_map<std::string, uint32_t> indices = { { std::string(), 0 } };
+};
+} // namespace
+
+static tile_id_table &get_tile_id_table()
+{
+    static tile_id_table table;
+    return table;
+}
+
+memorized_tile_id::memorized_tile_id( const std::string &id )
+{
+    tile_id_table &table = get_tile_id_table();
+    const auto it = table.indices.find( id );
+    if( it != table.indices.end() ) {
+        index = it->second;
+        return;
+    }
+    index = table.strings.size();
+    table.strings.push_back( id );
+    table.indices.emplace( id, index );
+}
+
+const std::string &memorized_tile_id::str() const
+{
+    return get_tile_id_table().strings[index];
+}
+
 mm_submap::mm_submap() = default;
 
 mm_region::mm_region() : submaps {{ nullptr }} {}
@@ -83,7 +115,7 @@ void map_memory::memorize_tile( const tripoint &pos, const std::string &ter,
 {
     coord_pair p( pos );
     mm_submap &sm = get_submap( p.sm );
-    sm.set_tile( p.loc, memorized_terrain_tile{ ter, subtile, rotation } );
+    sm.set_tile( p.loc, memorized_terrain_tile{ memorized_tile_id( ter ), subtile, rotation } );
 }
 
 int map_memory::get_symbol( const tripoint &pos )
@@ -203,11 +235,12 @@ static void temp_remove_open_air( const shared_ptr_fast<mm_submap> &sm )
     if( sm->is_empty() ) {
         return;
     }
+    static const memorized_tile_id open_air( "t_open_air" );
     for( int x = 0; x < SEEX; x++ ) {
         for( int y = 0; y < SEEY; y++ ) {
             const memorized_terrain_tile &t = sm->tile( {x, y} );
 
-            if( !t.tile.empty() && t.tile == "t_open_air" ) {
+            if( t.tile == open_air ) {
                 sm->set_tile( {x, y}, mm_submap::default_tile );
             }
         }
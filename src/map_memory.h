@@ -1,7 +1,9 @@
 #pragma once
 
-#include <map>
+#include <cstdint>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "game_constants.h"
 #include "memory_fast.h"
@@ -10,8 +12,47 @@
 class JsonOut;
 class JsonIn;
 
+/**
+ * Interned tileset id of a memorized tile.
+ * Every distinct id string is stored once for the whole game, so memorized tiles
+ * only carry an index into that table.  Default constructed ids are empty.
+ */
+class memorized_tile_id
+{
+    public:
+        memorized_tile_id() = default;
+        explicit memorized_tile_id( const std::string &id );
+
+        const std::string &str() const;
+
+        bool empty() const {
+            return index == 0;
+        }
+
+        bool operator==( const memorized_tile_id &rhs ) const {
+            return index == rhs.index;
+        }
+        bool operator!=( const memorized_tile_id &rhs ) const {
+            return index != rhs.index;
+        }
+
+    private:
+        friend struct std::hash<memorized_tile_id>;
+        uint32_t index = 0;
+};
+
+namespace std
+{
+template <>
+struct hash<memorized_tile_id> {
+    std::size_t operator()( const memorized_tile_id &k ) const noexcept {
+        return k.index;
+    }
+};
+} // namespace std
+
 struct memorized_terrain_tile {
-    std::string tile;
+    memorized_tile_id tile;
     int subtile;
     int rotation;
 
@@ -28,6 +69,7 @@ struct memorized_terrain_tile {
 struct mm_submap {
     public:
         friend class map_memory;
+        friend struct mm_region;
         static const memorized_terrain_tile default_tile;
         static const int default_symbol;
 
@@ -72,8 +114,14 @@ struct mm_submap {
             symbols[p.y * SEEX + p.x] = value;
         }
 
-        void serialize( JsonOut &jsout ) const;
-        void deserialize( JsonIn &jsin );
+        /** Tiles are written as their index in the region's string table, @p indices. */
+        void serialize( JsonOut &jsout,
+                        const std::unordered_map<memorized_tile_id, int> &indices ) const;
+        /**
+         * Read a submap written with the string table @p table, or with the tile id
+         * strings inline if it's null (saves from before string tables).
+         */
+        void deserialize( JsonIn &jsin, const std::vector<memorized_tile_id> *table );
 
     private:
         std::vector<memorized_terrain_tile> tiles; // holds either 0 or SEEX*SEEY elements
@@ -84,7 +132,8 @@ struct mm_submap {
 /**
  * Represents a square of mm_submaps.
  * For faster save/load, submaps are collected into regions
- * and each region is saved in its own file.
+ * and each region is saved in its own file, together with
+ * a table of the tile id strings used in it.
  */
 struct mm_region {
     shared_ptr_fast<mm_submap> submaps[MM_REG_SIZE][MM_REG_SIZE];
@@ -177,7 +226,7 @@ class map_memory
         void clear_memorized_tile( const tripoint &pos );
 
     private:
-        std::map<tripoint, shared_ptr_fast<mm_submap>> submaps;
+        std::unordered_map<tripoint, shared_ptr_fast<mm_submap>> submaps;
 
         std::vector<shared_ptr_fast<mm_submap>> cached;
         tripoint cache_pos;
@@ -18,10 +18,12 @@
 #include "game_constants.h"
 #include "json.h"
 #include "map.h"
+#include "options.h"
 #include "output.h"
 #include "popup.h"
 #include "string_formatter.h"
 #include "submap.h"
+#include "submap_binary.h"
 #include "translations.h"
 #include "ui_manager.h"
 #include "world.h"
@@ -84,6 +86,14 @@ submap *mapbuffer::lookup_submap( const tripoint &p )
     return iter->second.get();
 }
 
+void mapbuffer::prefetch_submap( const tripoint &p )
+{
+    if( submaps.contains( p ) ) {
+        return;
+    }
+    g->get_active_world()->prefetch_map_quad( sm_to_omt_copy( p ) );
+}
+
 void mapbuffer::save( bool delete_after_save )
 {
     int num_saved_submaps = 0;
@@ -136,6 +146,9 @@ void mapbuffer::save( bool delete_after_save )
                    om_addr.y > map_origin.y + HALF_MAPSIZE );
         num_saved_submaps += 4;
     }
+    // The save only counts once the quads are on disk, the game is written out right after.
+    g->get_active_world()->wait_for_map_writes(); // can throw
+
     for( auto &elem : submaps_to_delete ) {
         remove_submap( elem );
     }
@@ -182,7 +195,9 @@ void mapbuffer::save_quad( const tripoint &om_addr, std::list<tripoint> &submaps
         return;
     }
 
-    g->get_active_world()->write_map_quad( om_addr, [&]( std::ostream & fout ) {
+    // Only the serialization needs the game state; the world writes the result in the background.
+    std::ostringstream quad_data;
+    const auto serialize_quad = [&]( std::ostream & fout ) {
         JsonOut jsout( fout );
         jsout.start_array();
         for( auto &submap_addr : submap_addrs ) {
@@ -217,7 +232,24 @@ void mapbuffer::save_quad( const tripoint &om_addr, std::list<tripoint> &submaps
         }
 
         jsout.end_array();
-    } );
+    };
+    if( get_option<bool>( "BINARY_MAP_QUADS" ) ) {
+        std::vector<std::pair<tripoint, const submap *>> quad;
+        for( const tripoint &submap_addr : submap_addrs ) {
+            const auto it = submaps.find( submap_addr );
+            if( it == submaps.end() || it->second == nullptr ) {
+                continue;
+            }
+            quad.emplace_back( submap_addr, it->second.get() );
+            if( delete_after_save ) {
+                submaps_to_delete.push_back( submap_addr );
+            }
+        }
+        submap_binary::write_quad( quad_data, quad );
+    } else {
+        serialize_quad( quad_data );
+    }
+    g->get_active_world()->write_map_quad_async( om_addr, quad_data.str() );
 }
 
 // We're reading in way too many entities here to mess around with creating sub-objects and
@@ -227,9 +259,20 @@ submap *mapbuffer::unserialize_submaps( const tripoint &p )
     // Map the tripoint to the submap quad that stores it.
     const tripoint om_addr = sm_to_omt_copy( p );
 
-    using namespace std::placeholders;
-    if( !g->get_active_world()->read_map_quad( om_addr, std::bind( &mapbuffer::deserialize,
-            this, _1 ) ) ) {
+    const bool found = g->get_active_world()->read_map_quad( om_addr, [this]( std::istream & fin,
+    const std::string & path ) {
+        if( submap_binary::is_binary_quad( fin ) ) {
+            submap_binary::read_quad( fin, [this]( const tripoint & pos, std::unique_ptr<submap> &sm ) {
+                if( !add_submap( pos, sm ) ) {
+                    debugmsg( "submap %d,%d,%d was already loaded", pos.x, pos.y, pos.z );
+                }
+            } );
+        } else {
+            JsonIn jsin( fin, path );
+            deserialize( jsin );
+        }
+    } );
+    if( !found ) {
         // If it doesn't exist, trigger generating it.
         return nullptr;
     }
@@ -71,6 +71,12 @@ class mapbuffer
             return submaps.contains( p );
         }
 
+        /**
+         * Start reading the quad containing the submap from disk in the background, so a
+         * later @ref lookup_submap finds the data ready.  Does nothing if it's loaded.
+         */
+        void prefetch_submap( const tripoint &p );
+
     private:
         // There's a very good reason this is private,
         // if not handled carefully, this can erase in-use submaps and crash the game.
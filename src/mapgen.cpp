@@ -31,6 +31,7 @@
 #include "game.h"
 #include "game_constants.h"
 #include "generic_factory.h"
+#include "hash_utils.h"
 #include "input.h"
 #include "int_id.h"
 #include "item.h"
@@ -107,6 +108,17 @@ static void science_room( map *m, const point &p1, const point &p2, int z, int r
 
 // (x,y,z) are absolute coordinates of a submap
 // x%2 and y%2 must be 0!
+// Each overmap terrain rolls from its own seed, so what it turns into doesn't depend on
+// which terrains were generated before it.
+static unsigned int mapgen_seed( const tripoint_abs_omt &p )
+{
+    std::size_t seed = g->get_seed();
+    cata::hash_combine( seed, p.x() );
+    cata::hash_combine( seed, p.y() );
+    cata::hash_combine( seed, p.z() );
+    return static_cast<unsigned int>( seed );
+}
+
 void map::generate( const tripoint &p, const time_point &when )
 {
     dbg( DL::Info ) << "map::generate( g[" << g.get() << "], p[" << p <<
@@ -134,6 +146,7 @@ void map::generate( const tripoint &p, const time_point &when )
     // x, and y are submap coordinates, convert to overmap terrain coordinates
     // TODO: fix point types
     tripoint_abs_omt abs_omt( sm_to_omt_copy( p ) );
+    const rng_seed_scope seeded( mapgen_seed( abs_omt ) );
     oter_id terrain_type = overmap_buffer.ter( abs_omt );
 
     // This attempts to scale density of zombies inversely with distance from the nearest city.
@@ -1304,6 +1317,13 @@ class mapgen_value
         Id get( const mapgendata &dat ) const {
             return source_->get( dat );
         }
+        /** The id this value always resolves to, if it was given verbatim. */
+        std::optional<Id> constant() const {
+            if( const id_source *s = dynamic_cast<const id_source *>( source_.get() ) ) {
+                return s->id;
+            }
+            return std::nullopt;
+        }
         std::vector<StringId> all_possible_results( const mapgen_parameters &params ) const {
             return source_->all_possible_results( params );
         }
@@ -2285,6 +2305,9 @@ class jmapgen_furniture : public jmapgen_piece
             }
             dat.m.furn_set( point( x.get(), y.get() ), chosen_id );
         }
+        std::optional<furn_id> constant_furn() const override {
+            return id.constant();
+        }
         bool has_vehicle_collision( const mapgendata &dat, const point &p ) const override {
             return dat.m.veh_at( tripoint( p, dat.zlevel() ) ).has_value();
         }
@@ -2328,6 +2351,9 @@ class jmapgen_terrain : public jmapgen_piece
                 }
             }
         }
+        std::optional<ter_id> constant_ter() const override {
+            return id.constant();
+        }
         bool has_vehicle_collision( const mapgendata &dat, const point &p ) const override {
             return dat.m.veh_at( tripoint( p, dat.zlevel() ) ).has_value();
         }
@@ -3652,6 +3678,71 @@ void jmapgen_objects::finalize()
     []( const jmapgen_obj & l, const jmapgen_obj & r ) {
         return l.second->phase() < r.second->phase();
     } );
+    compile_plan();
+}
+
+void jmapgen_objects::compile_plan()
+{
+    const size_t squares = static_cast<size_t>( mapgensize.x ) * mapgensize.y;
+    plan_ter.assign( squares, t_null );
+    plan_furn.assign( squares, f_null );
+    plan_pieces.clear();
+
+    // The plan is applied at the start of its phase, so a constant piece may only be
+    // folded into it if no piece left in the same phase before it can touch its square.
+    std::vector<bool> touched( squares, false );
+    bool touched_anywhere = false;
+    mapgen_phase current_phase = mapgen_phase::terrain;
+    for( const jmapgen_obj &obj : objects ) {
+        const jmapgen_place &where = obj.first;
+        const jmapgen_piece &what = *obj.second;
+        if( what.phase() != current_phase ) {
+            current_phase = what.phase();
+            std::fill( touched.begin(), touched.end(), false );
+            touched_anywhere = false;
+        }
+
+        const point p( where.x.val, where.y.val );
+        const bool fixed_square = where.x.val == where.x.valmax && where.y.val == where.y.valmax &&
+                                  p.x >= 0 && p.y >= 0 && p.x < mapgensize.x && p.y < mapgensize.y;
+        // Ranged repeats roll rng even for constant pieces, keep those as they are.
+        const bool applied_once = where.repeat.val == where.repeat.valmax &&
+                                  what.repeat.val == what.repeat.valmax &&
+                                  std::max( where.repeat.val, what.repeat.val ) > 0;
+        const size_t i = fixed_square ? static_cast<size_t>( p.y ) * mapgensize.x + p.x : 0;
+        if( fixed_square && applied_once && !touched_anywhere && !touched[i] ) {
+            if( current_phase == mapgen_phase::terrain ) {
+                const std::optional<ter_id> ter = what.constant_ter();
+                // A second terrain on the same square must still see the first one, since
+                // placing a wall clears furniture and items.
+                if( ter && plan_ter[i] == t_null ) {
+                    if( *ter != t_null ) {
+                        plan_ter[i] = *ter;
+                    }
+                    continue;
+                }
+            } else if( current_phase == mapgen_phase::furniture ) {
+                if( const std::optional<furn_id> furn = what.constant_furn() ) {
+                    if( *furn != f_null ) {
+                        plan_furn[i] = *furn;
+                    }
+                    continue;
+                }
+            }
+        }
+
+        if( fixed_square ) {
+            touched[i] = true;
+        } else {
+            touched_anywhere = true;
+        }
+        plan_pieces.push_back( obj );
+    }
+
+    plan_furniture_start = std::find_if( plan_pieces.begin(), plan_pieces.end(),
+    []( const jmapgen_obj & obj ) {
+        return mapgen_phase::terrain < obj.second->phase();
+    } ) - plan_pieces.begin();
 }
 
 void jmapgen_objects::check( const std::string &oter_name,
@@ -3912,21 +4003,54 @@ void mapgen_function_json_nested::nest( const mapgendata &md, const point &offse
  */
 void jmapgen_objects::apply( const mapgendata &dat ) const
 {
-    for( auto &obj : objects ) {
-        const auto &where = obj.first;
-        const auto &what = *obj.second;
-        // The user will only specify repeat once in JSON, but it may get loaded both
-        // into the what and where in some cases--we just need the greater value of the two.
-        const int repeat = std::max( where.repeat.get(), what.repeat.get() );
-        for( int i = 0; i < repeat; i++ ) {
-            what.apply( dat, where.x, where.y );
+    const auto apply_pieces = [&dat]( auto first, auto last ) {
+        for( ; first != last; ++first ) {
+            const auto &where = first->first;
+            const auto &what = *first->second;
+            // The user will only specify repeat once in JSON, but it may get loaded both
+            // into the what and where in some cases--we just need the greater value of the two.
+            const int repeat = std::max( where.repeat.get(), what.repeat.get() );
+            for( int i = 0; i < repeat; i++ ) {
+                what.apply( dat, where.x, where.y );
+            }
+        }
+    };
+    const auto furniture_start = plan_pieces.begin() + plan_furniture_start;
+
+    // Same as jmapgen_terrain::apply for every square of the plan
+    const int z = dat.m.get_abs_sub().z;
+    for( int y = 0; y < mapgensize.y; y++ ) {
+        const ter_id *row = &plan_ter[static_cast<size_t>( y ) * mapgensize.x];
+        for( int x = 0; x < mapgensize.x; x++ ) {
+            if( row[x] == t_null ) {
+                continue;
+            }
+            const point p( x, y );
+            dat.m.ter_set( p, row[x] );
+            if( dat.m.has_flag_ter( TFLAG_WALL, p ) ) {
+                dat.m.furn_set( p, f_null );
+                if( !dat.m.has_flag_ter( "PLACE_ITEM", p ) ) {
+                    dat.m.i_clear( tripoint( p, z ) );
+                }
+            }
+        }
+    }
+    apply_pieces( plan_pieces.begin(), furniture_start );
+
+    for( int y = 0; y < mapgensize.y; y++ ) {
+        const furn_id *row = &plan_furn[static_cast<size_t>( y ) * mapgensize.x];
+        for( int x = 0; x < mapgensize.x; x++ ) {
+            if( row[x] != f_null ) {
+                dat.m.furn_set( point( x, y ), row[x] );
+            }
         }
     }
+    apply_pieces( furniture_start, plan_pieces.end() );
 }
 
 void jmapgen_objects::apply( const mapgendata &dat, const point &offset ) const
 {
-    if( offset == point_zero ) {
+    if( offset == point_zero && get_option<bool>( "PRECOMPILED_JSON_MAPGEN" ) ) {
         // It's a bit faster
         apply( dat );
         return;
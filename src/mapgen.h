@@ -2,6 +2,7 @@
 
 #include <cstddef>
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -196,6 +197,17 @@ class jmapgen_piece
         virtual void merge_parameters_into( mapgen_parameters &,
                                             const std::string &/*outer_context*/ ) const {}
 
+        /**
+         * Terrain / furniture this piece always places, without consulting rng or mapgen
+         * parameters. Such pieces can be folded into a @ref jmapgen_objects plan.
+         */
+        virtual std::optional<ter_id> constant_ter() const {
+            return std::nullopt;
+        }
+        virtual std::optional<furn_id> constant_furn() const {
+            return std::nullopt;
+        }
+
         /** Place something on the map from mapgendata &dat, at (x,y). */
         virtual void apply( const mapgendata &dat, const jmapgen_int &x, const jmapgen_int &y
                           ) const = 0;
@@ -365,6 +377,10 @@ struct jmapgen_objects {
         void load_objects( const JsonObject &jsi, const std::string &member_name );
 
         void check( const std::string &oter_name, const mapgen_parameters & ) const;
+        /**
+         * Sorts the pieces by phase and compiles the plan used by @ref apply at offset zero
+         * while the PRECOMPILED_JSON_MAPGEN option is on.
+         */
         void finalize();
 
         void merge_parameters_into( mapgen_parameters &, const std::string &outer_context ) const;
@@ -387,6 +403,20 @@ struct jmapgen_objects {
         point m_offset;
         point mapgensize;
         point total_size;
+
+        void compile_plan();
+
+        /**
+         * Terrain and furniture placed by constant pieces at fixed squares, one entry per
+         * square of mapgensize (index y * mapgensize.x + x). t_null / f_null leave the
+         * square alone. Built once by @ref finalize.
+         */
+        std::vector<ter_id> plan_ter;
+        std::vector<furn_id> plan_furn;
+        /** Pieces not folded into the plan, still in phase order. */
+        std::vector<jmapgen_obj> plan_pieces;
+        /** Index of the first entry in @ref plan_pieces past the terrain phase. */
+        size_t plan_furniture_start = 0;
 };
 
 class mapgen_function_json_base
@@ -403,7 +403,7 @@ void monster::plan()
             }
         }
     } else if( friendly != 0 && !docile && !waiting ) {
-        for( monster &tmp : g->all_monsters() ) {
+        const auto rate_hostile = [&]( monster & tmp ) {
             if( tmp.friendly == 0 ) {
                 float rating = rate_target( tmp, dist, smart_planning );
                 if( rating < dist ) {
@@ -411,6 +411,17 @@ void monster::plan()
                     dist = rating;
                 }
             }
+        };
+        if( smart_planning ) {
+            for( monster &tmp : g->all_monsters() ) {
+                rate_hostile( tmp );
+            }
+        } else {
+            // Nothing rates better than its distance, so only look at what's within sight range
+            for( const shared_ptr_fast<monster> &tmp : g->critter_tracker->find_in_radius( pos(),
+                    max_sight_range + 1, OVERMAP_LAYERS ) ) {
+                rate_hostile( *tmp );
+            }
         }
     }
 
@@ -700,6 +711,19 @@ bool monster::die_if_drowning( const tripoint &at_pos, const int chance )
     return false;
 }
 
+/**
+ * Creatures that monsters may be chasing.  Monsters route to them through a flow field seeded from
+ * all of them, so it has to list them the same way for everyone.
+ */
+static std::vector<tripoint> flow_field_targets()
+{
+    std::vector<tripoint> targets = { g->u.pos() };
+    for( const npc &guy : g->all_npcs() ) {
+        targets.push_back( guy.pos() );
+    }
+    return targets;
+}
+
 // General movement.
 // Currently, priority goes:
 // 1) Special Attack
@@ -869,13 +893,17 @@ void monster::move()
 
     // Set attitude to attitude to our current target
     monster_attitude current_attitude = attitude( nullptr );
+    // Is our goal the player or an NPC
+    bool chasing_target = false;
     if( !is_wandering() ) {
         if( goal == g->u.pos() ) {
             current_attitude = attitude( &g->u );
+            chasing_target = true;
         } else {
             for( const npc &guy : g->all_npcs() ) {
                 if( goal == guy.pos() ) {
                     current_attitude = attitude( &guy );
+                    chasing_target = true;
                 }
             }
         }
@@ -893,6 +921,17 @@ void monster::move()
     bool pathed_to_goal = this->path.empty() ? false : this->path.back() == goal;
 
     if( !this->is_wandering() ) {
+        if( this->pending_path.valid() ) {
+            // Requested on an earlier turn, so the goal may have moved since
+            std::optional<std::vector<tripoint>> pending = Pathfinding::collect_route( this->pending_path );
+            if( pending.has_value() ) {
+                this->pending_path = {};
+                if( !pending->empty() ) {
+                    this->path = std::move( *pending );
+                }
+            }
+        }
+
         if( this->repath_requested ) {
             std::vector<tripoint> maybe_new_path;
 
@@ -901,7 +940,29 @@ void monster::move()
                 maybe_new_path = g->m.route( this->pos(), this->goal, pf_settings, this->get_legacy_path_avoid() );
             } else {
                 auto pair = this->get_pathfinding_pair();
-                maybe_new_path = Pathfinding::route( this->pos(), this->goal, pair.first, pair.second );
+                if( get_option<bool>( "USE_FLOW_FIELD_PATHFINDING" ) && chasing_target ) {
+                    // Shared with every other monster of the same capabilities chasing anyone,
+                    //   usable as long as our target is the closest one
+                    maybe_new_path = Pathfinding::flow_route( this->pos(), flow_field_targets(), this->goal,
+                                     pair.first, pair.second );
+                }
+                if( !maybe_new_path.empty() ) {
+                    // Already found
+                } else if( get_option<bool>( "ASYNC_PATHFINDING" ) ) {
+                    // Otherwise still waiting on an earlier request
+                    if( !this->pending_path.valid() ) {
+                        this->pending_path = Pathfinding::request_route( this->pos(), this->goal,
+                                             pair.first, pair.second );
+                        // Short routes are found right away, long ones keep us on our old path until next turn
+                        std::optional<std::vector<tripoint>> found = Pathfinding::collect_route( this->pending_path );
+                        if( found.has_value() ) {
+                            this->pending_path = {};
+                            maybe_new_path = std::move( *found );
+                        }
+                    }
+                } else {
+                    maybe_new_path = Pathfinding::route( this->pos(), this->goal, pair.first, pair.second );
+                }
             }
 
             const bool is_pathfinding_successful = !maybe_new_path.empty();
@@ -4,6 +4,7 @@
 #include <climits>
 #include <cstddef>
 #include <functional>
+#include <future>
 #include <map>
 #include <optional>
 #include <set>
@@ -629,6 +630,8 @@ class monster : public Creature, public location_visitable<monster>
         /** Found path. Note: Not used by monsters that don't pathfind! **/
         std::vector<tripoint> path;
         bool repath_requested = false;
+        /** Route being found in the background, see Pathfinding::request_route **/
+        std::shared_future<std::vector<tripoint>> pending_path;
         std::bitset<NUM_MEFF> effect_cache;
         std::optional<time_duration> summon_time_limit = std::nullopt;
 
@@ -2306,6 +2306,46 @@ void options_manager::add_options_debug()
          translate_marker( "Use legacy pathfinding" ),
          translate_marker( "If true, opt out of new pathfinding in favor of legacy one. This makes pathfinding mods not work." ),
          false );
+
+    add( "USE_FLOW_FIELD_PATHFINDING", debug,
+         translate_marker( "Share pathfinding between monsters" ),
+         translate_marker( "If true, monsters chasing the player or NPCs follow a single map built from all of their positions at once, instead of every target getting its own map.  Has no effect with legacy pathfinding." ),
+         false );
+
+    add( "USE_HIERARCHICAL_PATHFINDING", debug,
+         translate_marker( "Plan long routes over submaps" ),
+         translate_marker( "If true, long routes are first planned between the edges of submaps, with the costs of crossing each submap cached until it changes, and then only worked out in detail between consecutive submap edges.  Has no effect with legacy pathfinding." ),
+         false );
+
+    add( "ASYNC_PATHFINDING", debug,
+         translate_marker( "Find long routes in the background" ),
+         translate_marker( "If true, monsters needing a long route have it worked out on worker threads between turns and keep to their old route until then.  Has no effect with legacy pathfinding." ),
+         false );
+
+    add( "OVERMAP_GENERATE_AHEAD", debug, translate_marker( "Generate overmaps ahead" ),
+         translate_marker( "When you get this many overmap tiles away from an overmap that hasn't been generated yet, it starts being generated in the background.  0 to only generate overmaps when they are needed.  Has no effect on worlds using the V2 save format." ),
+         0, OMAPX, 0
+       );
+
+    add( "SCENT_LAYERS", debug, translate_marker( "Separate scent layers" ),
+         translate_marker( "If true, every type of scent spreads on its own, so monsters can tell which one is strongest anywhere.  If false, all scent is of the type last left behind." ),
+         false );
+
+    add( "SOUND_PROPAGATION", debug, translate_marker( "Sound propagation" ),
+         translate_marker( "How monsters find out about sounds.  Clusters: sounds are merged into a few clusters, each checked against every monster in range.  Grid: the loudest sound reaching each small area of the map is worked out once per turn for the monsters there to hear.  Grid with walls: like grid, but sound has a harder time getting through solid terrain on its own Z level." ),
+    { { "clusters", translate_marker( "Clusters" ) }, { "grid", translate_marker( "Grid" ) }, { "grid_walls", translate_marker( "Grid with walls" ) } },
+    "clusters"
+       );
+
+    add( "PRECOMPILED_JSON_MAPGEN", debug,
+         translate_marker( "Precompiled JSON mapgen" ),
+         translate_marker( "If true, JSON mapgen places terrain and furniture that never changes from a per-square plan made when the mapgen is loaded.  If false, every piece is placed one by one.  Both give the same maps." ),
+         true );
+
+    add( "VERIFY_LIGHTMAP_CACHE", debug,
+         translate_marker( "Verify cached lightmap" ),
+         translate_marker( "If true, whenever the lightmap would be reused from the previous turn it is rebuilt from scratch and compared against the reused one, showing an error on mismatch.  Slow." ),
+         false );
 }
 
 void options_manager::add_options_world_default()
@@ -2325,6 +2365,13 @@ void options_manager::add_options_world_default()
 
     add_empty_line();
 
+    add( "BINARY_MAP_QUADS", world_default, translate_marker( "Compact map saves" ),
+         translate_marker( "If true, map data is saved in a compact binary format that loads faster than JSON.  Worlds can be switched either way at any time." ),
+         false
+       );
+
+    add_empty_line();
+
     add( "CITY_SIZE", world_default, translate_marker( "Size of cities" ),
          translate_marker( "A number determining how large cities are.  0 disables cities, roads and any scenario requiring a city start." ),
          0, 16, 8
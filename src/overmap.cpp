@@ -2883,6 +2883,23 @@ void overmap::populate( overmap_special_batch &enabled_specials )
 }
 
 void overmap::populate()
+{
+    overmap_special_batch enabled_specials = get_enabled_specials();
+    populate( enabled_specials );
+}
+
+void overmap::populate( const overmap *north, const overmap *east, const overmap *south,
+                        const overmap *west )
+{
+    overmap_special_batch enabled_specials = get_enabled_specials();
+    try {
+        generate( north, east, south, west, enabled_specials );
+    } catch( const std::exception &err ) {
+        debugmsg( "overmap %s failed to generate: %s", loc.to_string(), err.what() );
+    }
+}
+
+overmap_special_batch overmap::get_enabled_specials() const
 {
     overmap_special_batch enabled_specials = overmap_specials::get_default_batch( loc );
     const overmap_feature_flag_settings &overmap_feature_flag = settings->overmap_feature_flag;
@@ -2917,7 +2934,7 @@ void overmap::populate()
         }
     }
 
-    populate( enabled_specials );
+    return enabled_specials;
 }
 
 oter_id overmap::get_default_terrain( int z ) const
@@ -4084,7 +4101,8 @@ void overmap::place_forests()
     const oter_id forest( "forest" );
     const oter_id forest_thick( "forest_thick" );
 
-    const om_noise::om_noise_layer_forest f( global_base_point(), g->get_seed() );
+    const om_noise::om_noise_layer_forest layer( global_base_point(), g->get_seed() );
+    const om_noise::om_noise_grid f( layer );
 
     for( int x = 0; x < OMAPX; x++ ) {
         for( int y = 0; y < OMAPY; y++ ) {
@@ -4111,7 +4129,9 @@ void overmap::place_forests()
 
 void overmap::place_lakes()
 {
-    const om_noise::om_noise_layer_lake f( global_base_point(), g->get_seed() );
+    const om_noise::om_noise_layer_lake layer( global_base_point(), g->get_seed() );
+    // Flood fills run off the overmap, where the grid falls back to the layer.
+    const om_noise::om_noise_grid f( layer );
 
     const auto is_lake = [&]( const point_om_omt & p ) {
         return f.noise_at( p ) > settings->overmap_lake.noise_threshold_lake;
@@ -4432,7 +4452,8 @@ void overmap::place_swamps()
     const oter_id forest_water( "forest_water" );
 
     // Get a layer of noise to use in conjunction with our river buffered floodplain.
-    const om_noise::om_noise_layer_floodplain f( global_base_point(), g->get_seed() );
+    const om_noise::om_noise_layer_floodplain layer( global_base_point(), g->get_seed() );
+    const om_noise::om_noise_grid f( layer );
 
     for( int x = 0; x < OMAPX; x++ ) {
         for( int y = 0; y < OMAPY; y++ ) {
@@ -205,6 +205,12 @@ class overmap
          **/
         void populate( overmap_special_batch &enabled_specials );
         void populate();
+        /**
+         * Generate a new overmap next to the given neighbors, which may be null,
+         * without looking for it or its neighbors on disk or in the overmap buffer.
+         **/
+        void populate( const overmap *north, const overmap *east, const overmap *south,
+                       const overmap *west );
 
         const point_abs_om &pos() const {
             return loc;
@@ -383,6 +389,8 @@ class overmap
 
         // Initialize
         void init_layers();
+        // The default specials, filtered by the region's feature flags
+        overmap_special_batch get_enabled_specials() const;
         // open existing overmap, or generate a new one
         void open( overmap_special_batch &enabled_specials );
     public:
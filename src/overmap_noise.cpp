@@ -1,5 +1,8 @@
 #include <cmath>
 #include <algorithm>
+#include <future>
+#include <thread>
+#include <vector>
 
 #include "overmap_noise.h"
 #include "simplexnoise.h"
@@ -7,6 +10,15 @@
 namespace om_noise
 {
 
+void om_noise_layer::noise_rows( const int first_x, const int last_x, float *out ) const
+{
+    for( int x = first_x; x < last_x; x++ ) {
+        for( int y = 0; y < OMAPY; y++ ) {
+            *out++ = noise_at( point_om_omt( x, y ) );
+        }
+    }
+}
+
 float om_noise_layer_forest::noise_at( const point_om_omt &local_omt_pos ) const
 {
     const point_abs_omt p = global_omt_pos( local_omt_pos );
@@ -19,6 +31,21 @@ float om_noise_layer_forest::noise_at( const point_om_omt &local_omt_pos ) const
     return std::max( 0.0f, r - d * 0.5f );
 }
 
+void om_noise_layer_forest::noise_rows( const int first_x, const int last_x, float *out ) const
+{
+    const point_abs_omt p = global_omt_pos( point_om_omt( first_x, 0 ) );
+    const int width = last_x - first_x;
+    std::vector<float> d( width * OMAPY );
+    scaled_octave_noise_3d_grid( 8, 0.5, 0.03, 0, 1, p.x(), p.y(), get_seed(), width, OMAPY, out );
+    scaled_octave_noise_3d_grid( 12, 0.5, 0.07, 0, 1, p.x(), p.y(), get_seed(), width, OMAPY,
+                                 d.data() );
+    for( size_t i = 0; i < d.size(); i++ ) {
+        const float r = std::pow( out[i], 2.0f );
+        const float di = std::pow( d[i], 3.0f );
+        out[i] = std::max( 0.0f, r - di * 0.5f );
+    }
+}
+
 float om_noise_layer_floodplain::noise_at( const point_om_omt &local_omt_pos ) const
 {
     const point_abs_omt p = global_omt_pos( local_omt_pos );
@@ -27,6 +54,17 @@ float om_noise_layer_floodplain::noise_at( const point_om_omt &local_omt_pos ) c
     return r;
 }
 
+void om_noise_layer_floodplain::noise_rows( const int first_x, const int last_x,
+        float *out ) const
+{
+    const point_abs_omt p = global_omt_pos( point_om_omt( first_x, 0 ) );
+    const int width = last_x - first_x;
+    scaled_octave_noise_3d_grid( 8, 0.5, 0.05, 0, 1, p.x(), p.y(), get_seed(), width, OMAPY, out );
+    for( int i = 0; i < width * OMAPY; i++ ) {
+        out[i] = std::pow( out[i], 2.0f );
+    }
+}
+
 float om_noise_layer_lake::noise_at( const point_om_omt &local_omt_pos ) const
 {
     const point_abs_omt p = global_omt_pos( local_omt_pos );
@@ -35,4 +73,42 @@ float om_noise_layer_lake::noise_at( const point_om_omt &local_omt_pos ) const
     return r;
 }
 
+void om_noise_layer_lake::noise_rows( const int first_x, const int last_x, float *out ) const
+{
+    const point_abs_omt p = global_omt_pos( point_om_omt( first_x, 0 ) );
+    const int width = last_x - first_x;
+    scaled_octave_noise_3d_grid( 16, 0.5, 0.002, 0, 1, p.x(), p.y(), get_seed(), width, OMAPY, out );
+    for( int i = 0; i < width * OMAPY; i++ ) {
+        out[i] = std::pow( out[i], 4.0f );
+    }
+}
+
+om_noise_grid::om_noise_grid( const om_noise_layer &layer ) : layer( layer ),
+    values( OMAPX * OMAPY )
+{
+    const auto fill_rows = [&]( const int first, const int last ) {
+        layer.noise_rows( first, last, values.data() + first * OMAPY );
+    };
+    const int num_bands = std::min<int>( OMAPX, std::max( 1U, std::thread::hardware_concurrency() ) );
+    const int band_size = ( OMAPX + num_bands - 1 ) / num_bands;
+    std::vector<std::future<void>> workers;
+    for( int first = band_size; first < OMAPX; first += band_size ) {
+        workers.push_back( std::async( std::launch::async, fill_rows, first,
+                                       std::min( first + band_size, OMAPX ) ) );
+    }
+    fill_rows( 0, std::min( band_size, OMAPX ) );
+    for( std::future<void> &worker : workers ) {
+        worker.get();
+    }
+}
+
+float om_noise_grid::noise_at( const point_om_omt &omt_local ) const
+{
+    const point &p = omt_local.raw();
+    if( p.x < 0 || p.x >= OMAPX || p.y < 0 || p.y >= OMAPY ) {
+        return layer.noise_at( omt_local );
+    }
+    return values[p.x * OMAPY + p.y];
+}
+
 } // namespace om_noise
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <vector>
+
 #include "coordinates.h"
 #include "game_constants.h"
 #include "point.h"
@@ -19,6 +21,11 @@ class om_noise_layer
          * @param omt_local point location in overmap terrain local coordinates.
          */
         virtual float noise_at( const point_om_omt &omt_local ) const = 0;
+        /**
+         * Noise values for the rows [first_x, last_x) of the overmap, written to
+         * out[( x - first_x ) * OMAPY + y].  Calls noise_at unless overridden.
+         */
+        virtual void noise_rows( int first_x, int last_x, float *out ) const;
         virtual ~om_noise_layer() = default;
     protected:
         /**
@@ -54,6 +61,7 @@ class om_noise_layer_forest : public om_noise_layer
         }
 
         float noise_at( const point_om_omt &local_omt_pos ) const override;
+        void noise_rows( int first_x, int last_x, float *out ) const override;
 };
 
 class om_noise_layer_floodplain : public om_noise_layer
@@ -64,6 +72,7 @@ class om_noise_layer_floodplain : public om_noise_layer
         }
 
         float noise_at( const point_om_omt &local_omt_pos ) const override;
+        void noise_rows( int first_x, int last_x, float *out ) const override;
 };
 
 class om_noise_layer_lake : public om_noise_layer
@@ -74,6 +83,29 @@ class om_noise_layer_lake : public om_noise_layer
         }
 
         float noise_at( const point_om_omt &local_omt_pos ) const override;
+        void noise_rows( int first_x, int last_x, float *out ) const override;
+};
+
+/**
+ * Values of a noise layer for every terrain of one overmap, worked out up front.
+ * Bands of rows are computed on worker threads.  Noise only depends on position
+ * and seed, so the values are exactly what the layer's noise_at would return.
+ */
+class om_noise_grid
+{
+    public:
+        explicit om_noise_grid( const om_noise_layer &layer );
+
+        /**
+         * Noise value at the provided overmap terrain location.  Locations outside
+         * the overmap are passed on to the layer.
+         */
+        float noise_at( const point_om_omt &omt_local ) const;
+
+    private:
+        const om_noise_layer &layer;
+        /** Indexed by x * OMAPY + y. */
+        std::vector<float> values;
 };
 
 } // namespace om_noise
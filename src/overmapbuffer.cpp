@@ -9,6 +9,7 @@
 #include <map>
 #include <optional>
 #include <queue>
+#include <tuple>
 #include <future>
 
 #include "avatar.h"
@@ -73,6 +74,16 @@ omt_find_params::~omt_find_params() = default;
 
 omt_route_params::~omt_route_params() = default;
 
+// Set on the thread generating an overmap for generate_ahead, which must not wait for itself.
+static thread_local bool generating_ahead = false;
+
+// What generating an overmap reads from an existing neighbor, copied for generate_ahead.
+struct overmap_neighbor {
+    point_abs_om pos;
+    std::vector<oter_id> terrain;
+    std::map<overmap_connection_id, std::vector<tripoint_om_omt>> connections_out;
+};
+
 overmap &overmapbuffer::get( const point_abs_om &p )
 {
     {
@@ -83,6 +94,17 @@ overmap &overmapbuffer::get( const point_abs_om &p )
         }
     }
 
+    if( !generating_ahead ) {
+        // The missing overmap may be the one being generated ahead.  Otherwise, finish it
+        // anyway, so that both are generated with the other as a neighbor.
+        finish_generating_ahead( true );
+        read_lock<std::shared_mutex> _l( mutex );
+        const auto it = overmaps.find( p );
+        if( it != overmaps.end() ) {
+            return *it->second.get();
+        }
+    }
+
     overmap *new_om;
     {
         write_lock<std::shared_mutex> _l( mutex );
@@ -153,6 +175,123 @@ void overmapbuffer::generate( const std::vector<point_abs_om> &locs )
     }
 }
 
+void overmapbuffer::generate_ahead( const tripoint_abs_omt &center, const int distance )
+{
+    if( distance <= 0 || generating_ahead ) {
+        return;
+    }
+    // Reading through the database connection is limited to the main thread, and
+    // generating an overmap looks for its neighbors on disk.
+    const world *active_world = g->get_active_world();
+    if( active_world == nullptr ||
+        active_world->info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
+        return;
+    }
+    finish_generating_ahead( false );
+    {
+        std::lock_guard<std::mutex> _al( ahead_mutex );
+        if( ahead ) {
+            return;
+        }
+    }
+    const point_abs_om center_om = project_to<coords::om>( center.xy() );
+    for( const point_abs_om &p : closest_points_first( center_om, 1 ) ) {
+        // Distance from the center to the nearest terrain of that overmap.
+        const point_abs_omt first = project_to<coords::omt>( p );
+        const point_abs_omt last = first + point( OMAPX - 1, OMAPY - 1 );
+        const int dx = std::max( { first.x() - center.x(), center.x() - last.x(), 0 } );
+        const int dy = std::max( { first.y() - center.y(), center.y() - last.y(), 0 } );
+        if( std::max( dx, dy ) > distance ) {
+            continue;
+        }
+        {
+            read_lock<std::shared_mutex> _l( mutex );
+            if( overmaps.contains( p ) ) {
+                continue;
+            }
+        }
+        // Loading an overmap creates NPCs, which isn't safe off the main thread.
+        if( active_world->overmap_exists( p ) ) {
+            continue;
+        }
+        // The game may change the neighbors while this one is generated, so it gets copies
+        // of the parts that generating reads: the surface terrain and the connections out.
+        std::array<std::optional<overmap_neighbor>, 4> neighbors;
+        const std::array<point, 4> sides = { point_north, point_east, point_south, point_west };
+        for( size_t i = 0; i < sides.size(); i++ ) {
+            const overmap *other = get_existing( p + sides[i] );
+            if( other == nullptr ) {
+                continue;
+            }
+            overmap_neighbor &neighbor = neighbors[i].emplace();
+            neighbor.pos = other->pos();
+            const map_layer &surface = other->layer[OVERMAP_DEPTH];
+            neighbor.terrain.assign( &surface.terrain[0][0], &surface.terrain[0][0] + OMAPX * OMAPY );
+            neighbor.connections_out = other->connections_out;
+        }
+        std::lock_guard<std::mutex> _al( ahead_mutex );
+        if( !ahead ) {
+            ahead.emplace();
+            ahead->pos = p;
+            ahead->result = std::async( std::launch::async, [p, neighbors = std::move( neighbors )]() {
+                generating_ahead = true;
+                std::unique_ptr<overmap> new_om;
+                // debugmsg shows a prompt, so messages are passed on to the main thread.
+                std::string errors = capture_debugmsg_during( [&]() {
+                    new_om = std::make_unique<overmap>( p );
+                    std::array<std::unique_ptr<overmap>, 4> copies;
+                    for( size_t i = 0; i < neighbors.size(); i++ ) {
+                        if( !neighbors[i] ) {
+                            continue;
+                        }
+                        copies[i] = std::make_unique<overmap>( neighbors[i]->pos );
+                        map_layer &surface = copies[i]->layer[OVERMAP_DEPTH];
+                        std::copy( neighbors[i]->terrain.begin(), neighbors[i]->terrain.end(),
+                                   &surface.terrain[0][0] );
+                        copies[i]->connections_out = neighbors[i]->connections_out;
+                    }
+                    new_om->populate( copies[0].get(), copies[1].get(), copies[2].get(), copies[3].get() );
+                } );
+                return std::make_pair( std::move( new_om ), std::move( errors ) );
+            } );
+        }
+        return;
+    }
+}
+
+void overmapbuffer::finish_generating_ahead( const bool wait )
+{
+    overmap *new_om = nullptr;
+    std::string errors;
+    {
+        std::lock_guard<std::mutex> _al( ahead_mutex );
+        if( !ahead ) {
+            return;
+        }
+        if( !wait && ahead->result.wait_for( std::chrono::seconds( 0 ) ) != std::future_status::ready ) {
+            return;
+        }
+        std::unique_ptr<overmap> result;
+        std::tie( result, errors ) = ahead->result.get();
+        const point_abs_om pos = ahead->pos;
+        ahead.reset();
+
+        write_lock<std::shared_mutex> _l( mutex );
+        // Another worker may have generated the same overmap in the meantime.
+        if( !overmaps.contains( pos ) ) {
+            new_om = result.get();
+            overmaps[pos] = std::move( result );
+        }
+    }
+    if( !errors.empty() ) {
+        debugmsg( "%s", errors );
+    }
+    if( new_om != nullptr ) {
+        fix_mongroups( *new_om );
+        fix_npcs( *new_om );
+    }
+}
+
 void overmapbuffer::fix_mongroups( overmap &new_overmap )
 {
     for( auto it = new_overmap.zg.begin(); it != new_overmap.zg.end(); ) {
@@ -240,6 +379,7 @@ void overmapbuffer::fix_npcs( overmap &new_overmap )
 
 void overmapbuffer::save()
 {
+    finish_generating_ahead( true );
     read_lock<std::shared_mutex> _l( mutex );
 
     for( auto &omp : overmaps ) {
@@ -250,10 +390,18 @@ void overmapbuffer::save()
 
 void overmapbuffer::clear()
 {
+    {
+        std::lock_guard<std::mutex> _al( ahead_mutex );
+        if( ahead ) {
+            ahead->result.wait();
+            ahead.reset();
+        }
+    }
     write_lock<std::shared_mutex> _l( mutex );
 
     overmaps.clear();
     known_non_existing.clear();
+    std::lock_guard<std::mutex> _ul( placed_unique_specials_mutex );
     placed_unique_specials.clear();
 }
 
@@ -999,14 +1147,19 @@ bool overmapbuffer::check_overmap_special_type( const overmap_special_id &id,
 
 void overmapbuffer::add_unique_special( const overmap_special_id &id )
 {
-    if( contains_unique_special( id ) ) {
+    bool added;
+    {
+        std::lock_guard<std::mutex> _ul( placed_unique_specials_mutex );
+        added = placed_unique_specials.emplace( id ).second;
+    }
+    if( !added ) {
         debugmsg( "Unique overmap special placed more than once: %s", id.str() );
     }
-    placed_unique_specials.emplace( id );
 }
 
 bool overmapbuffer::contains_unique_special( const overmap_special_id &id ) const
 {
+    std::lock_guard<std::mutex> _ul( placed_unique_specials_mutex );
     return placed_unique_specials.contains( id );
 }
 
@@ -2,7 +2,9 @@
 
 #include <array>
 #include <functional>
+#include <future>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <set>
 #include <string>
@@ -175,6 +177,21 @@ class overmapbuffer
         */
         void generate( const std::vector<point_abs_om> &locs );
 
+        /**
+         * Starts generating a new overmap on a worker thread if one is missing within
+         * @p distance overmap terrains of @p center.  Only one is generated at a time,
+         * and overmaps that exist on disk are left to @ref get.  It is generated next to
+         * copies of its neighbors, as those may change while it runs.
+         * @ref get waits for it instead of generating it again.
+         */
+        void generate_ahead( const tripoint_abs_omt &center, int distance );
+        /**
+         * Adds the overmap from @ref generate_ahead to the loaded overmaps.  Saving
+         * waits for it, so that the unique specials it placed are saved with it.
+         * @param wait Wait for it if it isn't done yet, otherwise leave it be.
+         */
+        void finish_generating_ahead( bool wait );
+
         /**
          * Returns the overmap terrain at the given OMT coordinates.
          * Creates a new overmap if necessary.
@@ -518,6 +535,16 @@ class overmapbuffer
                                    const omt_find_params &params );
 
         std::unordered_map< point_abs_om, std::unique_ptr< overmap > > overmaps;
+
+        /** Overmap being generated by @ref generate_ahead. */
+        struct overmap_ahead {
+            point_abs_om pos;
+            /** The new overmap and the debug messages from generating it. */
+            std::future<std::pair<std::unique_ptr<overmap>, std::string>> result;
+        };
+        std::optional<overmap_ahead> ahead;
+        /** Guards @ref ahead, and is held while waiting for it. */
+        std::mutex ahead_mutex;
         /**
          * Set of overmap coordinates of overmaps that are known
          * to not exist on disk. See @ref get_existing for usage.
@@ -526,6 +553,8 @@ class overmapbuffer
 
         // Set of globally unique overmap specials that have already been placed
         std::unordered_set<overmap_special_id> placed_unique_specials;
+        // Guards placed_unique_specials, which @ref generate_ahead adds to from its thread
+        mutable std::mutex placed_unique_specials_mutex;
 
         /**
          * Get a list of notes in the (loaded) overmaps.
@@ -1,14 +1,18 @@
 #include "pathfinding.h"
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <optional>
 #include <queue>
+#include <thread>
 #include <vector>
 
 #include "game.h"
 #include "map.h"
 #include "map_iterator.h"
+#include "options.h"
 #include "point.h"
 #include "submap.h"
 #include "trap.h"
@@ -30,6 +34,18 @@ static constexpr std::array<point, 8> DIRS_2D = {
 
 decltype( Pathfinding::d_maps_store ) Pathfinding::d_maps_store = {};
 decltype( Pathfinding::d_maps ) Pathfinding::d_maps = {};
+decltype( Pathfinding::flow_fields ) Pathfinding::flow_fields = {};
+decltype( Pathfinding::chunk_graphs ) Pathfinding::chunk_graphs = {};
+decltype( Pathfinding::expanded_tiles ) Pathfinding::expanded_tiles = 0;
+decltype( Pathfinding::route_requests ) Pathfinding::route_requests = {};
+decltype( Pathfinding::route_workers ) Pathfinding::route_workers = {};
+
+// Routes at least this long are planned over chunks first
+static constexpr int HIERARCHICAL_MIN_DIST = 3 * SEEX;
+// Chunk graphs kept at once, one per distinct `PathfindingSettings`
+static constexpr size_t MAX_CHUNK_GRAPHS = 32;
+// Shorter routes are cheap enough to not bother worker threads with
+static constexpr int ASYNC_MIN_DIST = HIERARCHICAL_MIN_DIST;
 decltype( Pathfinding::z_area ) Pathfinding::z_area = {};
 decltype( Pathfinding::z_caches ) Pathfinding::z_caches = {};
 decltype( Pathfinding::z_caches_open_air ) Pathfinding::z_caches_open_air = {};
@@ -166,6 +182,10 @@ float &Pathfinding::g_at( const point &p )
 {
     return this->g_map[p.y][p.x];
 };
+int &Pathfinding::flow_origin_at( const point &p )
+{
+    return this->flow_origin[p.y * MAPSIZE_X + p.x];
+}
 float Pathfinding::get_f_unbiased( const point &p )
 {
     return this->p_at( p ) + this->g_at( p );
@@ -181,7 +201,7 @@ Pathfinding::State &Pathfinding::tile_state_at( const point &p )
     return this->tile_state[p.y + 1][p.x + 1];
 }
 /// Pathfinding: d-map wide changes
-void Pathfinding::produce_d_map( point dest, int z, PathfindingSettings settings )
+std::unique_ptr<Pathfinding> Pathfinding::take_stored_map()
 {
     if( Pathfinding::d_maps_store.empty() ) {
         std::unique_ptr<Pathfinding> d_map = std::make_unique<Pathfinding>();
@@ -190,6 +210,11 @@ void Pathfinding::produce_d_map( point dest, int z, PathfindingSettings settings
 
     std::unique_ptr<Pathfinding> d_map = std::move( Pathfinding::d_maps_store.back() );
     Pathfinding::d_maps_store.pop_back();
+    return d_map;
+}
+void Pathfinding::produce_d_map( point dest, int z, PathfindingSettings settings )
+{
+    std::unique_ptr<Pathfinding> d_map = Pathfinding::take_stored_map();
 
     d_map->dest = dest;
     d_map->z = z;
@@ -197,19 +222,51 @@ void Pathfinding::produce_d_map( point dest, int z, PathfindingSettings settings
 
     Pathfinding::d_maps.push_back( std::move( d_map ) );
 }
+Pathfinding &Pathfinding::get_flow_field( const std::vector<point> &dests, int z,
+        const PathfindingSettings &settings )
+{
+    auto field_it = std::ranges::find_if( Pathfinding::flow_fields,
+    [&dests, &settings, z]( auto & map ) {
+        return map->z == z && map->flow_dests == dests && map->settings == settings;
+    } );
+    if( field_it != Pathfinding::flow_fields.end() ) {
+        return **field_it;
+    }
+
+    std::unique_ptr<Pathfinding> field = Pathfinding::take_stored_map();
+
+    field->dest = dests.front();
+    field->z = z;
+    field->settings = settings;
+    field->flow_dests = dests;
+    field->expand_flow_field();
+
+    Pathfinding::flow_fields.push_back( std::move( field ) );
+    return *Pathfinding::flow_fields.back();
+}
 void Pathfinding::clear_d_maps()
 {
-    for( auto &map : Pathfinding::d_maps ) {
-        map->reset_maps();
-        map->reset_tile_state();
-        map->unbiased_frontier.clear();
-        map->forbidden_moves.clear();
-        map->domain = Pathfinding::MapDomain::RELATIVE_DOMAIN;
-        map->is_explored = false;
-        Pathfinding::d_maps_store.push_back( std::move( map ) );
-    }
-    Pathfinding::d_maps.clear();
+    for( auto *maps : {
+             &Pathfinding::d_maps, &Pathfinding::flow_fields
+         } ) {
+        for( auto &map : *maps ) {
+            map->reset_maps();
+            map->reset_tile_state();
+            map->unbiased_frontier.clear();
+            map->forbidden_moves.clear();
+            map->flow_dests.clear();
+            map->domain = Pathfinding::MapDomain::RELATIVE_DOMAIN;
+            map->is_explored = false;
+            Pathfinding::d_maps_store.push_back( std::move( map ) );
+        }
+        maps->clear();
+    }
     Pathfinding::cached_closest_z_changes.clear();
+    // Routes nobody handed out are for a map that may be gone, answer them with no route
+    for( RouteJob &job : Pathfinding::route_requests ) {
+        job.result.set_value( std::vector<tripoint>() );
+    }
+    Pathfinding::route_requests.clear();
 }
 void Pathfinding::reset_maps()
 {
@@ -462,6 +519,180 @@ void Pathfinding::detect_culled_frontier(
     out = std::move( flood_fill );
 }
 
+std::optional<float> Pathfinding::step_g( const map &here, const point &cur_point,
+        const point &next_point, const vehicle *next_vehicle )
+{
+    const point dir = cur_point - next_point;
+    const tripoint cur_point_with_z = tripoint( cur_point, this->z );
+    const tripoint next_point_with_z = tripoint( next_point, this->z );
+
+    const bool can_open_doors = !is_inf( this->settings.door_open_cost );
+    const bool can_bash = this->settings.bash_strength_val > 0;
+    const bool can_climb = !is_inf( this->settings.climb_cost );
+    const bool care_about_mobs = this->settings.mob_presence_penalty > 0;
+    const bool care_about_traps = this->settings.trap_cost > 0;
+
+    int cur_vehicle_part;
+    const vehicle *cur_vehicle;
+    cur_vehicle = here.veh_at_internal( cur_point_with_z, cur_vehicle_part );
+
+    {
+        bool is_move_valid = true;
+
+        const bool is_valid_to_step_into_veh =
+            cur_vehicle == nullptr ?
+            true :
+            cur_vehicle->allowed_move( cur_vehicle->tripoint_to_mount( cur_point_with_z ),
+                                       cur_vehicle->tripoint_to_mount( next_point_with_z ) );
+
+        const bool is_valid_to_step_out_of_veh =
+            next_vehicle == nullptr ?
+            true :
+            next_vehicle->allowed_move( next_vehicle->tripoint_to_mount( cur_point_with_z ),
+                                        next_vehicle->tripoint_to_mount( next_point_with_z ) );
+
+        is_move_valid &= is_valid_to_step_into_veh;
+        is_move_valid &= is_valid_to_step_out_of_veh;
+
+        if( !is_move_valid ) {
+            this->forbidden_moves.emplace( cur_point, next_point );
+            return std::nullopt;
+        }
+    }
+
+    const maptile &new_tile = here.maptile_at_internal( cur_point_with_z );
+    const auto &terrain = new_tile.get_ter_t();
+    const auto &furniture = new_tile.get_furn_t();
+    const int move_cost = here.move_cost_internal( furniture, terrain, cur_vehicle, cur_vehicle_part );
+
+    float cur_g = this->g_at( cur_point );
+    // May be false for relative search, so we'll reuse g-values there
+    const bool is_g_calc_needed = cur_g == 0.0;
+
+    if( is_g_calc_needed ) {
+        bool is_diag = dir.x != 0 && dir.y != 0;
+        cur_g += is_diag ? 0.75 * move_cost : 0.5 * move_cost;
+        cur_g *= this->settings.move_cost_coeff;
+
+        // First, check for trivial cost modifiers
+        const bool is_rough = move_cost > 2;
+        const bool is_sharp = terrain.has_flag( TFLAG_SHARP );
+
+        cur_g += is_rough ? this->settings.rough_terrain_cost : 0.0;
+        cur_g += is_sharp ? this->settings.sharp_terrain_cost : 0.0;
+
+        if( care_about_mobs && !std::isinf( cur_g ) ) {
+            cur_g += g->critter_at( cur_point_with_z, true ) != nullptr ?
+                     this->settings.mob_presence_penalty :
+                     0.0;
+        }
+
+        if( care_about_traps && !std::isinf( cur_g ) ) {
+            const trap &maybe_ter_trap = terrain.trap.obj();
+            const trap &maybe_trap = maybe_ter_trap.is_benign() ? new_tile.get_trap_t() : maybe_ter_trap;
+            const bool is_trap = !maybe_trap.is_benign();
+
+            cur_g += is_trap ? this->settings.trap_cost : 0.0;
+        }
+
+        const bool is_ledge = here.has_zlevels() && terrain.has_flag( TFLAG_NO_FLOOR );
+        if( is_ledge && !this->settings.can_fly ) {
+            // Close ledges outright for non-fliers
+            cur_g += INFINITY;
+        }
+
+        // And finally, add a potential field extra
+        if( !std::isinf( cur_g ) && this->settings.extra_g_costs.contains( cur_point ) ) {
+            cur_g += this->settings.extra_g_costs.at( cur_point );
+        }
+
+        const bool is_passable = move_cost != 0;
+        float obstacle_g = 0;
+        // Calculate the cost for if the tile is impassable
+        while( !std::isinf( cur_g ) && !is_passable ) {
+            const bool is_climbable = terrain.has_flag( TFLAG_CLIMBABLE );
+            const bool is_door = !!terrain.open || !!furniture.open;
+
+            if( cur_vehicle != nullptr ) {
+                // Do processing for possible vehicle first
+                const auto vpobst = vpart_position( const_cast<vehicle &>( *cur_vehicle ),
+                                                    cur_vehicle_part ).obstacle_at_part();
+                const int obstacle_part = vpobst ? vpobst->part_index() : -1;
+
+                if( obstacle_part >= 0 ) {
+                    int _;
+                    const bool part_is_door = cur_vehicle->part_flag( obstacle_part, VPFLAG_OPENABLE );
+                    const bool part_opens_from_inside = cur_vehicle->part_flag( obstacle_part, "OPENCLOSE_INSIDE" );
+                    const bool is_cur_point_inside = here.veh_at_internal( cur_point_with_z, _ ) == next_vehicle;
+                    const bool valid_to_open = part_is_door && ( part_opens_from_inside ? is_cur_point_inside : true );
+
+                    if( can_open_doors && valid_to_open ) {
+                        obstacle_g = this->settings.door_open_cost;
+                    } else if( can_bash ) {
+                        const int htd = cur_vehicle->hits_to_destroy( obstacle_part,
+                                        this->settings.bash_strength_val * this->settings.bash_strength_quanta,
+                                        DT_BASH );
+                        if( htd == 0 ) {
+                            // We cannot bash down this part
+                            obstacle_g = INFINITY;
+                            break;
+                        } else {
+                            obstacle_g = this->settings.bash_cost * htd;
+                            break;
+                        }
+                    } else {
+                        // Nothing can be done here. Don't bother with other checks since vehicles take priority.
+                        obstacle_g = INFINITY;
+                        break;
+                    }
+                }
+            }
+
+            if( is_climbable && can_climb ) {
+                obstacle_g = this->settings.climb_cost;
+                break;
+            }
+            if( is_door && can_open_doors ) {
+                // Doors that can only be open from the inside
+                const bool door_opens_from_inside = terrain.has_flag( "OPENCLOSE_INSIDE" ) ||
+                                                    furniture.has_flag( "OPENCLOSE_INSIDE" );
+                const bool is_cur_point_inside = !here.is_outside( cur_point );
+                const bool valid_to_open = door_opens_from_inside ? is_cur_point_inside : true;
+                if( valid_to_open ) {
+                    obstacle_g = this->settings.door_open_cost;
+                    break;
+                }
+            }
+            if( can_bash ) {
+                // Time to consider bashing the obstacle
+                const int rating = here.bash_rating_internal(
+                                       this->settings.bash_strength_val * this->settings.bash_strength_quanta,
+                                       furniture, terrain, false, cur_vehicle, cur_vehicle_part );
+                if( rating > 1 ) {
+                    obstacle_g = ( 10. / rating ) * this->settings.bash_cost;
+                    break;
+                } else if( rating == 1 ) {
+                    // Rating == 1 implies it will take at least 10 turns to take this down
+                    //   which is a very unattractive target
+                    //   so we'll penalize this target a lot
+                    obstacle_g = 30.0 * this->settings.bash_cost * this->settings.bash_cost * this->settings.bash_cost;
+                    break;
+                }
+
+            }
+            // We can do nothing anymore, close the tile
+            obstacle_g = INFINITY;
+            break;
+        }
+
+        cur_g += obstacle_g;
+
+        this->g_at( cur_point ) = cur_g;
+    }
+
+    return cur_g;
+}
+
 Pathfinding::ExpansionOutcome Pathfinding::expand_2d_up_to(
     const point &start,
     const RouteSettings &route_settings )
@@ -528,11 +759,6 @@ Pathfinding::ExpansionOutcome Pathfinding::expand_2d_up_to(
     std::unordered_set<point> culled_frontier;
     ExpansionOutcome result = ExpansionOutcome::UNSET;
 
-    const bool can_open_doors = !is_inf( this->settings.door_open_cost );
-    const bool can_bash = this->settings.bash_strength_val > 0;
-    const bool can_climb = !is_inf( this->settings.climb_cost );
-    const bool care_about_mobs = this->settings.mob_presence_penalty > 0;
-    const bool care_about_traps = this->settings.trap_cost > 0;
     const map &here = get_map();
 
     while( !biased_frontier.empty() ) {
@@ -545,6 +771,7 @@ Pathfinding::ExpansionOutcome Pathfinding::expand_2d_up_to(
         const point next_point = biased_frontier.top().second;
 
         biased_frontier.pop();
+        Pathfinding::expanded_tiles++;
 
         if( !unculled_area.empty() && !unculled_area.contains( next_point ) ) {
             culled_frontier.insert( next_point );
@@ -568,7 +795,6 @@ Pathfinding::ExpansionOutcome Pathfinding::expand_2d_up_to(
         for( const point &dir : DIRS_2D ) {
             // It's cur_point because we're working backwards from destination
             const point cur_point = next_point + dir;
-            const tripoint cur_point_with_z = tripoint( cur_point, this->z );
 
             if( !this->in_bounds( cur_point ) ) {
                 continue;
@@ -578,163 +804,11 @@ Pathfinding::ExpansionOutcome Pathfinding::expand_2d_up_to(
                 continue;
             }
 
-            int cur_vehicle_part;
-            const vehicle *cur_vehicle;
-            cur_vehicle = here.veh_at_internal( cur_point_with_z, cur_vehicle_part );
-
-            {
-                bool is_move_valid = true;
-
-                const bool is_valid_to_step_into_veh =
-                    cur_vehicle == nullptr ?
-                    true :
-                    cur_vehicle->allowed_move( cur_vehicle->tripoint_to_mount( cur_point_with_z ),
-                                               cur_vehicle->tripoint_to_mount( next_point_with_z ) );
-
-                const bool is_valid_to_step_out_of_veh =
-                    next_vehicle == nullptr ?
-                    true :
-                    next_vehicle->allowed_move( next_vehicle->tripoint_to_mount( cur_point_with_z ),
-                                                next_vehicle->tripoint_to_mount( next_point_with_z ) );
-
-                is_move_valid &= is_valid_to_step_into_veh;
-                is_move_valid &= is_valid_to_step_out_of_veh;
-
-                if( !is_move_valid ) {
-                    this->forbidden_moves.emplace( cur_point, next_point );
-                    continue;
-                }
-            }
-
-            const maptile &new_tile = here.maptile_at_internal( cur_point_with_z );
-            const auto &terrain = new_tile.get_ter_t();
-            const auto &furniture = new_tile.get_furn_t();
-            const int move_cost = here.move_cost_internal( furniture, terrain, cur_vehicle, cur_vehicle_part );
-
-            float cur_g = this->g_at( cur_point );
-            // May be false for relative search, so we'll reuse g-values there
-            const bool is_g_calc_needed = cur_g == 0.0;
-
-            if( is_g_calc_needed ) {
-                bool is_diag = dir.x != 0 && dir.y != 0;
-                cur_g += is_diag ? 0.75 * move_cost : 0.5 * move_cost;
-                cur_g *= this->settings.move_cost_coeff;
-
-                // First, check for trivial cost modifiers
-                const bool is_rough = move_cost > 2;
-                const bool is_sharp = terrain.has_flag( TFLAG_SHARP );
-
-                cur_g += is_rough ? this->settings.rough_terrain_cost : 0.0;
-                cur_g += is_sharp ? this->settings.sharp_terrain_cost : 0.0;
-
-                if( care_about_mobs && !std::isinf( cur_g ) ) {
-                    cur_g += g->critter_at( cur_point_with_z, true ) != nullptr ?
-                             this->settings.mob_presence_penalty :
-                             0.0;
-                }
-
-                if( care_about_traps && !std::isinf( cur_g ) ) {
-                    const trap &maybe_ter_trap = terrain.trap.obj();
-                    const trap &maybe_trap = maybe_ter_trap.is_benign() ? new_tile.get_trap_t() : maybe_ter_trap;
-                    const bool is_trap = !maybe_trap.is_benign();
-
-                    cur_g += is_trap ? this->settings.trap_cost : 0.0;
-                }
-
-                const bool is_ledge = here.has_zlevels() && terrain.has_flag( TFLAG_NO_FLOOR );
-                if( is_ledge && !this->settings.can_fly ) {
-                    // Close ledges outright for non-fliers
-                    cur_g += INFINITY;
-                }
-
-                // And finally, add a potential field extra
-                if( !std::isinf( cur_g ) && this->settings.extra_g_costs.contains( cur_point ) ) {
-                    cur_g += this->settings.extra_g_costs.at( cur_point );
-                }
-
-                const bool is_passable = move_cost != 0;
-                float obstacle_g = 0;
-                // Calculate the cost for if the tile is impassable
-                while( !std::isinf( cur_g ) && !is_passable ) {
-                    const bool is_climbable = terrain.has_flag( TFLAG_CLIMBABLE );
-                    const bool is_door = !!terrain.open || !!furniture.open;
-
-                    if( cur_vehicle != nullptr ) {
-                        // Do processing for possible vehicle first
-                        const auto vpobst = vpart_position( const_cast<vehicle &>( *cur_vehicle ),
-                                                            cur_vehicle_part ).obstacle_at_part();
-                        const int obstacle_part = vpobst ? vpobst->part_index() : -1;
-
-                        if( obstacle_part >= 0 ) {
-                            int _;
-                            const bool part_is_door = cur_vehicle->part_flag( obstacle_part, VPFLAG_OPENABLE );
-                            const bool part_opens_from_inside = cur_vehicle->part_flag( obstacle_part, "OPENCLOSE_INSIDE" );
-                            const bool is_cur_point_inside = here.veh_at_internal( cur_point_with_z, _ ) == next_vehicle;
-                            const bool valid_to_open = part_is_door && ( part_opens_from_inside ? is_cur_point_inside : true );
-
-                            if( can_open_doors && valid_to_open ) {
-                                obstacle_g = this->settings.door_open_cost;
-                            } else if( can_bash ) {
-                                const int htd = cur_vehicle->hits_to_destroy( obstacle_part,
-                                                this->settings.bash_strength_val * this->settings.bash_strength_quanta,
-                                                DT_BASH );
-                                if( htd == 0 ) {
-                                    // We cannot bash down this part
-                                    obstacle_g = INFINITY;
-                                    break;
-                                } else {
-                                    obstacle_g = this->settings.bash_cost * htd;
-                                    break;
-                                }
-                            } else {
-                                // Nothing can be done here. Don't bother with other checks since vehicles take priority.
-                                obstacle_g = INFINITY;
-                                break;
-                            }
-                        }
-                    }
-
-                    if( is_climbable && can_climb ) {
-                        obstacle_g = this->settings.climb_cost;
-                        break;
-                    }
-                    if( is_door && can_open_doors ) {
-                        // Doors that can only be open from the inside
-                        const bool door_opens_from_inside = terrain.has_flag( "OPENCLOSE_INSIDE" ) ||
-                                                            furniture.has_flag( "OPENCLOSE_INSIDE" );
-                        const bool is_cur_point_inside = !here.is_outside( cur_point );
-                        const bool valid_to_open = door_opens_from_inside ? is_cur_point_inside : true;
-                        if( valid_to_open ) {
-                            obstacle_g = this->settings.door_open_cost;
-                            break;
-                        }
-                    }
-                    if( can_bash ) {
-                        // Time to consider bashing the obstacle
-                        const int rating = here.bash_rating_internal(
-                                               this->settings.bash_strength_val * this->settings.bash_strength_quanta,
-                                               furniture, terrain, false, cur_vehicle, cur_vehicle_part );
-                        if( rating > 1 ) {
-                            obstacle_g = ( 10. / rating ) * this->settings.bash_cost;
-                            break;
-                        } else if( rating == 1 ) {
-                            // Rating == 1 implies it will take at least 10 turns to take this down
-                            //   which is a very unattractive target
-                            //   so we'll penalize this target a lot
-                            obstacle_g = 30.0 * this->settings.bash_cost * this->settings.bash_cost * this->settings.bash_cost;
-                            break;
-                        }
-
-                    }
-                    // We can do nothing anymore, close the tile
-                    obstacle_g = INFINITY;
-                    break;
-                }
-
-                cur_g += obstacle_g;
-
-                this->g_at( cur_point ) = cur_g;
+            const std::optional<float> maybe_g = this->step_g( here, cur_point, next_point, next_vehicle );
+            if( !maybe_g ) {
+                continue;
             }
+            const float cur_g = *maybe_g;
 
             this->p_at( cur_point ) = this->get_f_unbiased( next_point );
 
@@ -791,67 +865,114 @@ Pathfinding::ExpansionOutcome Pathfinding::expand_2d_up_to(
     return result;
 }
 
-
-std::vector<tripoint> Pathfinding::get_route_2d(
-    const point from, const point to, const int z,
-    const PathfindingSettings path_settings,
-    const RouteSettings route_settings )
+void Pathfinding::expand_flow_field()
 {
-    if( from == to ) {
-        return std::vector<tripoint> { tripoint( from, z ), tripoint( to, z ) };
-    }
+    using Frontier = std::priority_queue<val_pair, std::vector<val_pair>, pair_greater_cmp_first>;
 
-    auto d_map_it = std::ranges::find_if(
-                        Pathfinding::d_maps,
-    [&to, &path_settings, z]( auto & map ) {
-        return map->dest == to && map->z == z && map->settings == path_settings;
-    } );
+    // Unlike `expand_2d_up_to` there's no single start to bias towards, so this is plain dijikstra
+    Frontier frontier;
 
-    Pathfinding *d_map;
-    if( d_map_it == Pathfinding::d_maps.end() ) {
-        Pathfinding::produce_d_map( to, z, path_settings );
-        d_map = Pathfinding::d_maps.back().get();
-    } else {
-        d_map = d_map_it->get();
-    }
+    this->reset_tile_state();
+    this->flow_origin.resize( MAPSIZE_X * MAPSIZE_Y );
 
-    if( !d_map->is_in_limited_domain( from, from, route_settings ) ) {
-        // This should only fail if max f-limit is failed
-        return std::vector<tripoint>();
+    for( size_t i = 0; i < this->flow_dests.size(); i++ ) {
+        const point &p = this->flow_dests[i];
+        if( this->tile_state_at( p ) != Pathfinding::State::UNVISITED ) {
+            // Several destinations on the same tile
+            continue;
+        }
+        this->tile_state_at( p ) = Pathfinding::State::ACCESSIBLE;
+        this->p_at( p ) = 0.0;
+        this->g_at( p ) = 0.0;
+        this->flow_origin_at( p ) = i;
+        this->map_modify_set.push_back( p );
+        this->tile_state_modify_set.push_back( p );
+        frontier.emplace( 0.0, p );
     }
 
-    if( d_map->expand_2d_up_to( from, route_settings ) != ExpansionOutcome::PATH_FOUND ) {
-        return std::vector<tripoint>();
+    const map &here = get_map();
+
+    while( !frontier.empty() ) {
+        const point next_point = frontier.top().second;
+        frontier.pop();
+        Pathfinding::expanded_tiles++;
+
+        int _;
+        const vehicle *next_vehicle;
+        next_vehicle = here.veh_at_internal( tripoint( next_point, this->z ), _ );
+
+        for( const point &dir : DIRS_2D ) {
+            const point cur_point = next_point + dir;
+
+            if( !this->in_bounds( cur_point ) ) {
+                continue;
+            }
+
+            if( this->tile_state_at( cur_point ) != Pathfinding::State::UNVISITED ) {
+                continue;
+            }
+
+            const std::optional<float> maybe_g = this->step_g( here, cur_point, next_point, next_vehicle );
+            if( !maybe_g ) {
+                continue;
+            }
+            const float cur_g = *maybe_g;
+
+            this->p_at( cur_point ) = this->get_f_unbiased( next_point );
+            this->flow_origin_at( cur_point ) = this->flow_origin_at( next_point );
+
+            if( is_inf( cur_g ) ) {
+                this->tile_state_at( cur_point ) = Pathfinding::State::IMPASSABLE;
+            } else {
+                this->tile_state_at( cur_point ) = Pathfinding::State::ACCESSIBLE;
+                frontier.emplace( this->get_f_unbiased( cur_point ), cur_point );
+            }
+
+            this->map_modify_set.push_back( cur_point );
+            this->tile_state_modify_set.push_back( cur_point );
+        }
     }
 
+    this->domain = MapDomain::ABSOLUTE_DOMAIN;
+    this->is_explored = true;
+}
+
+std::vector<tripoint> Pathfinding::trace_route( const point &from, const point &to,
+        const RouteSettings &route_settings )
+{
     const int chebyshev_distance = square_dist_fast(
-                                       tripoint( from, d_map->z ),
-                                       tripoint( d_map->dest, d_map->z ) );
+                                       tripoint( from, this->z ),
+                                       tripoint( to, this->z ) );
     const float max_s = route_settings.max_s_coeff * chebyshev_distance;
 
+    // Flow fields lead to several destinations, don't let the route wander off to another one
+    const bool is_flow_field = !this->flow_dests.empty();
+    const int origin = is_flow_field ? this->flow_origin_at( from ) : 0;
+
     std::vector<tripoint> result;
-    result.push_back( tripoint( from, d_map->z ) );
+    result.push_back( tripoint( from, this->z ) );
 
     point cur_point = from;
-    float cur_cost = d_map->get_f_unbiased( cur_point );
+    float cur_cost = this->get_f_unbiased( cur_point );
 
-    while( cur_point != d_map->dest ) {
+    while( cur_point != to ) {
         std::vector<std::pair<float, point>> candidates;
 
         for( const point &dir : DIRS_2D ) {
             const point next_point = cur_point + dir;
-            const bool is_in_bounds = d_map->in_bounds( next_point );
+            const bool is_in_bounds = this->in_bounds( next_point );
             if( !is_in_bounds ) {
                 continue;
             }
 
-            const float cost = d_map->get_f_unbiased( next_point );
+            const float cost = this->get_f_unbiased( next_point );
 
-            const bool is_accessible = d_map->tile_state_at( next_point ) ==
+            const bool is_accessible = this->tile_state_at( next_point ) ==
                                        Pathfinding::State::ACCESSIBLE;
-            const bool is_not_forbidden = !d_map->forbidden_moves.contains( {cur_point, next_point} );
+            const bool is_not_forbidden = !this->forbidden_moves.contains( {cur_point, next_point} );
+            const bool is_same_origin = !is_flow_field || this->flow_origin_at( next_point ) == origin;
 
-            const bool is_valid = is_accessible && is_not_forbidden;
+            const bool is_valid = is_accessible && is_not_forbidden && is_same_origin;
             if( !is_valid ) {
                 continue;
             };
@@ -875,7 +996,7 @@ std::vector<tripoint> Pathfinding::get_route_2d(
 
         const auto selected_pair = &candidates[route_settings.rank_weighted_rng( candidates.size() )];
 
-        result.push_back( tripoint( selected_pair->second, d_map->z ) );
+        result.push_back( tripoint( selected_pair->second, this->z ) );
         cur_point = selected_pair->second;
         cur_cost = selected_pair->first;
 
@@ -891,6 +1012,395 @@ std::vector<tripoint> Pathfinding::get_route_2d(
     return result;
 }
 
+float Pathfinding::chunk_tile_cost( const map &here, const point &p )
+{
+    int _;
+    const vehicle *veh = here.veh_at_internal( tripoint( p, this->z ), _ );
+    const std::optional<float> g = this->step_g( here, p, p, veh );
+    this->map_modify_set.push_back( p );
+    return g.value_or( INFINITY );
+}
+
+// Dijkstra from `source` restricted to a single chunk, filling `dist` with the cost of reaching every tile of it
+static void chunk_dijkstra( const std::array<float, SEEX *SEEY> &tile_costs, const point &source,
+                            std::array<float, SEEX *SEEY> &dist, uint64_t &expanded_tiles )
+{
+    using val_pair = std::pair<float, point>;
+    std::priority_queue<val_pair, std::vector<val_pair>, pair_greater_cmp_first> frontier;
+
+    dist.fill( INFINITY );
+    dist[source.y * SEEX + source.x] = 0.0;
+    frontier.emplace( 0.0, source );
+
+    while( !frontier.empty() ) {
+        const auto [cost, p] = frontier.top();
+        frontier.pop();
+        if( cost > dist[p.y * SEEX + p.x] ) {
+            continue;
+        }
+        expanded_tiles++;
+
+        for( const point &dir : DIRS_2D ) {
+            const point next = p + dir;
+            if( next.x < 0 || next.x >= SEEX || next.y < 0 || next.y >= SEEY ) {
+                continue;
+            }
+            const float tile_cost = tile_costs[next.y * SEEX + next.x];
+            if( is_inf( tile_cost ) ) {
+                continue;
+            }
+            const bool is_diag = dir.x != 0 && dir.y != 0;
+            const float next_cost = cost + ( is_diag ? 1.5f * tile_cost : tile_cost );
+            if( next_cost < dist[next.y * SEEX + next.x] ) {
+                dist[next.y * SEEX + next.x] = next_cost;
+                frontier.emplace( next_cost, next );
+            }
+        }
+    }
+}
+
+Pathfinding::ChunkGraph &Pathfinding::get_chunk_graph( int z, const PathfindingSettings &settings )
+{
+    const point abs_sub = get_map().get_abs_sub().xy();
+
+    auto graph_it = std::ranges::find_if( Pathfinding::chunk_graphs,
+    [&settings, z]( auto & graph ) {
+        return graph->z == z && graph->settings == settings;
+    } );
+
+    if( graph_it == Pathfinding::chunk_graphs.end() ) {
+        if( Pathfinding::chunk_graphs.size() >= MAX_CHUNK_GRAPHS ) {
+            Pathfinding::chunk_graphs.erase( Pathfinding::chunk_graphs.begin() );
+        }
+        std::unique_ptr<ChunkGraph> graph = std::make_unique<ChunkGraph>();
+        graph->z = z;
+        graph->settings = settings;
+        graph->abs_sub = abs_sub;
+        Pathfinding::chunk_graphs.push_back( std::move( graph ) );
+        return *Pathfinding::chunk_graphs.back();
+    }
+
+    ChunkGraph &graph = **graph_it;
+    if( graph.abs_sub != abs_sub ) {
+        // Map was shifted, so every chunk is somewhere else now
+        graph.abs_sub = abs_sub;
+        for( auto &row : graph.chunks ) {
+            for( Chunk &chunk : row ) {
+                chunk.revision = -1;
+            }
+        }
+    }
+    return graph;
+}
+
+const Pathfinding::Chunk &Pathfinding::get_chunk( ChunkGraph &graph, const point &chunk_pos )
+{
+    const map &here = get_map();
+    Chunk &chunk = graph.chunks[chunk_pos.y][chunk_pos.x];
+
+    const int revision = here.get_pathfinding_revision( tripoint( chunk_pos, graph.z ) );
+    if( chunk.revision == revision ) {
+        return chunk;
+    }
+
+    chunk.revision = revision;
+    chunk.portals.clear();
+    chunk.costs.clear();
+    chunk.border_portal.fill( -1 );
+    chunk.border_cost.fill( INFINITY );
+
+    const point origin( chunk_pos.x * SEEX, chunk_pos.y * SEEY );
+
+    // Borrow a d_map to calculate g-values with
+    {
+        std::unique_ptr<Pathfinding> scratch = Pathfinding::take_stored_map();
+        scratch->z = graph.z;
+        scratch->settings = graph.settings;
+        for( int y = 0; y < SEEY; y++ ) {
+            for( int x = 0; x < SEEX; x++ ) {
+                chunk.tile_costs[y * SEEX + x] = scratch->chunk_tile_cost( here, origin + point( x, y ) );
+            }
+        }
+        scratch->reset_maps();
+        scratch->forbidden_moves.clear();
+        Pathfinding::d_maps_store.push_back( std::move( scratch ) );
+    }
+
+    // Sides of the chunk with another chunk behind them, as their first tile and the direction along them
+    std::vector<std::pair<point, point>> sides;
+    if( chunk_pos.y > 0 ) {
+        sides.emplace_back( point_zero, point_east );
+    }
+    if( chunk_pos.y < MAPSIZE - 1 ) {
+        sides.emplace_back( point( 0, SEEY - 1 ), point_east );
+    }
+    if( chunk_pos.x > 0 ) {
+        sides.emplace_back( point_zero, point_south );
+    }
+    if( chunk_pos.x < MAPSIZE - 1 ) {
+        sides.emplace_back( point( SEEX - 1, 0 ), point_south );
+    }
+
+    // One portal in the middle of each open stretch of every side
+    std::vector<std::vector<point>> portal_stretches;
+    for( const auto &[first, along] : sides ) {
+        std::vector<point> stretch;
+        for( int i = 0; i <= SEEX; i++ ) {
+            const point p = first + along * i;
+            const bool is_open = i < SEEX && !is_inf( chunk.tile_costs[p.y * SEEX + p.x] );
+            if( is_open ) {
+                stretch.push_back( p );
+                continue;
+            }
+            if( stretch.empty() ) {
+                continue;
+            }
+            const point portal = stretch[stretch.size() / 2];
+            auto portal_it = std::ranges::find( chunk.portals, portal );
+            if( portal_it == chunk.portals.end() ) {
+                chunk.portals.push_back( portal );
+                portal_stretches.emplace_back();
+                portal_it = chunk.portals.end() - 1;
+            }
+            std::vector<point> &portal_stretch = portal_stretches[portal_it - chunk.portals.begin()];
+            portal_stretch.insert( portal_stretch.end(), stretch.begin(), stretch.end() );
+            stretch.clear();
+        }
+    }
+
+    const size_t num_portals = chunk.portals.size();
+    chunk.costs.resize( num_portals * num_portals );
+    std::array<float, SEEX *SEEY> dist;
+    for( size_t i = 0; i < num_portals; i++ ) {
+        chunk_dijkstra( chunk.tile_costs, chunk.portals[i], dist, Pathfinding::expanded_tiles );
+        for( size_t j = 0; j < num_portals; j++ ) {
+            const point &other = chunk.portals[j];
+            chunk.costs[i * num_portals + j] = dist[other.y * SEEX + other.x];
+        }
+        for( const point &p : portal_stretches[i] ) {
+            chunk.border_portal[p.y * SEEX + p.x] = i;
+            chunk.border_cost[p.y * SEEX + p.x] = dist[p.y * SEEX + p.x];
+        }
+    }
+
+    for( point &portal : chunk.portals ) {
+        portal += origin;
+    }
+
+    return chunk;
+}
+
+std::vector<tripoint> Pathfinding::get_route_hierarchical(
+    const point from, const point to, const int z,
+    const PathfindingSettings path_settings,
+    const RouteSettings route_settings )
+{
+    using val_pair = std::pair<float, int>;
+
+    PathfindingSettings chunk_settings = path_settings;
+    // Creatures move around too much to be baked into chunks, they're accounted for when refining the route
+    chunk_settings.mob_presence_penalty = 0;
+    ChunkGraph &graph = Pathfinding::get_chunk_graph( z, chunk_settings );
+
+    const point from_chunk( from.x / SEEX, from.y / SEEY );
+    const point to_chunk( to.x / SEEX, to.y / SEEY );
+    if( from_chunk == to_chunk ) {
+        return std::vector<tripoint>();
+    }
+
+    // Nodes are portals, identified by chunk and index of the portal in it
+    constexpr int max_portals = 4 * SEEX;
+    constexpr int start_node = -1;
+    constexpr int goal_node = -2;
+    const auto node_of = []( const point & chunk_pos, int portal ) {
+        return ( chunk_pos.y * MAPSIZE + chunk_pos.x ) * max_portals + portal;
+    };
+    const auto chunk_of = []( int node ) {
+        const int chunk_index = node / max_portals;
+        return point( chunk_index % MAPSIZE, chunk_index / MAPSIZE );
+    };
+
+    const Chunk &first = Pathfinding::get_chunk( graph, from_chunk );
+    const Chunk &last = Pathfinding::get_chunk( graph, to_chunk );
+    std::array<float, SEEX *SEEY> from_dist;
+    std::array<float, SEEX *SEEY> to_dist;
+    chunk_dijkstra( first.tile_costs, from - from_chunk * SEEX, from_dist, Pathfinding::expanded_tiles );
+    // Costs are about the same either way, so this stands in for the cost of reaching `to` from each tile
+    chunk_dijkstra( last.tile_costs, to - to_chunk * SEEX, to_dist, Pathfinding::expanded_tiles );
+
+    const auto heuristic = [&to, &path_settings]( const point & p ) {
+        return square_dist( p, to ) * path_settings.move_cost_coeff;
+    };
+
+    std::priority_queue<val_pair, std::vector<val_pair>, pair_greater_cmp_first> frontier;
+    std::unordered_map<int, float> best_g;
+    std::unordered_map<int, int> came_from;
+    std::unordered_set<int> closed;
+
+    const auto relax = [&]( int node, int parent, float g_val, const point & p ) {
+        if( is_inf( g_val ) ) {
+            return;
+        }
+        auto best_it = best_g.find( node );
+        if( best_it != best_g.end() && best_it->second <= g_val ) {
+            return;
+        }
+        best_g[node] = g_val;
+        came_from[node] = parent;
+        frontier.emplace( g_val + heuristic( p ), node );
+    };
+
+    for( size_t i = 0; i < first.portals.size(); i++ ) {
+        const point local = first.portals[i] - from_chunk * SEEX;
+        relax( node_of( from_chunk, i ), start_node, from_dist[local.y * SEEX + local.x], first.portals[i] );
+    }
+
+    bool found = false;
+    while( !frontier.empty() ) {
+        const int node = frontier.top().second;
+        frontier.pop();
+        if( node == goal_node ) {
+            found = true;
+            break;
+        }
+        if( !closed.insert( node ).second ) {
+            continue;
+        }
+
+        const point chunk_pos = chunk_of( node );
+        const int portal = node % max_portals;
+        const Chunk &chunk = Pathfinding::get_chunk( graph, chunk_pos );
+        const point portal_pos = chunk.portals[portal];
+        const float node_g = best_g[node];
+
+        if( chunk_pos == to_chunk ) {
+            const point local = portal_pos - to_chunk * SEEX;
+            relax( goal_node, node, node_g + to_dist[local.y * SEEX + local.x], to );
+        }
+
+        // Through this chunk to its other portals
+        const size_t num_portals = chunk.portals.size();
+        for( size_t i = 0; i < num_portals; i++ ) {
+            if( static_cast<int>( i ) != portal ) {
+                relax( node_of( chunk_pos, i ), node, node_g + chunk.costs[portal * num_portals + i],
+                       chunk.portals[i] );
+            }
+        }
+
+        // Across the border, to portals of the stretches next to this one
+        for( const point &dir : DIRS_2D ) {
+            const point next = portal_pos + dir;
+            if( next.x < 0 || next.x >= MAPSIZE_X || next.y < 0 || next.y >= MAPSIZE_Y ) {
+                continue;
+            }
+            const point next_chunk_pos( next.x / SEEX, next.y / SEEY );
+            if( next_chunk_pos == chunk_pos ) {
+                continue;
+            }
+            const Chunk &next_chunk = Pathfinding::get_chunk( graph, next_chunk_pos );
+            const point local = next - next_chunk_pos * SEEX;
+            const int next_portal = next_chunk.border_portal[local.y * SEEX + local.x];
+            if( next_portal < 0 ) {
+                continue;
+            }
+            const bool is_diag = dir.x != 0 && dir.y != 0;
+            const float tile_cost = next_chunk.tile_costs[local.y * SEEX + local.x];
+            relax( node_of( next_chunk_pos, next_portal ), node,
+                   node_g + ( is_diag ? 1.5f * tile_cost : tile_cost ) +
+                   next_chunk.border_cost[local.y * SEEX + local.x],
+                   next_chunk.portals[next_portal] );
+        }
+    }
+
+    if( !found ) {
+        return std::vector<tripoint>();
+    }
+
+    std::vector<int> portal_path;
+    for( int node = came_from[goal_node]; node != start_node; node = came_from[node] ) {
+        portal_path.push_back( node );
+    }
+    std::ranges::reverse( portal_path );
+
+    // Refine the route only between the portals we leave chunks through, so every segment crosses a single chunk
+    std::vector<point> waypoints;
+    for( size_t i = 0; i + 1 < portal_path.size(); i++ ) {
+        const point chunk_pos = chunk_of( portal_path[i] );
+        if( chunk_pos != chunk_of( portal_path[i + 1] ) ) {
+            waypoints.push_back( graph.chunks[chunk_pos.y][chunk_pos.x].portals[portal_path[i] % max_portals] );
+        }
+    }
+    waypoints.push_back( to );
+
+    std::vector<tripoint> result;
+    point cur_point = from;
+    for( const point &waypoint : waypoints ) {
+        if( waypoint == cur_point ) {
+            continue;
+        }
+        const std::vector<tripoint> segment = Pathfinding::get_route_2d( cur_point, waypoint, z,
+                                              path_settings, route_settings );
+        if( segment.empty() ) {
+            return std::vector<tripoint>();
+        }
+        // Consecutive segments share their ends
+        result.insert( result.end(), result.empty() ? segment.begin() : segment.begin() + 1, segment.end() );
+        cur_point = waypoint;
+    }
+
+    const float max_s = route_settings.max_s_coeff * square_dist( from, to );
+    if( result.size() - 2 > max_s ) {
+        return std::vector<tripoint>();
+    }
+
+    return result;
+}
+
+std::vector<tripoint> Pathfinding::get_route_2d(
+    const point from, const point to, const int z,
+    const PathfindingSettings path_settings,
+    const RouteSettings route_settings )
+{
+    if( from == to ) {
+        return std::vector<tripoint> { tripoint( from, z ), tripoint( to, z ) };
+    }
+
+    const bool is_long_route = square_dist( from, to ) >= HIERARCHICAL_MIN_DIST;
+    if( is_long_route && !route_settings.is_relative_search_domain() &&
+        get_option<bool>( "USE_HIERARCHICAL_PATHFINDING" ) ) {
+        std::vector<tripoint> result = Pathfinding::get_route_hierarchical( from, to, z, path_settings,
+                                       route_settings );
+        if( !result.empty() ) {
+            return result;
+        }
+    }
+
+    auto d_map_it = std::ranges::find_if(
+                        Pathfinding::d_maps,
+    [&to, &path_settings, z]( auto & map ) {
+        return map->dest == to && map->z == z && map->settings == path_settings;
+    } );
+
+    Pathfinding *d_map;
+    if( d_map_it == Pathfinding::d_maps.end() ) {
+        Pathfinding::produce_d_map( to, z, path_settings );
+        d_map = Pathfinding::d_maps.back().get();
+    } else {
+        d_map = d_map_it->get();
+    }
+
+    if( !d_map->is_in_limited_domain( from, from, route_settings ) ) {
+        // This should only fail if max f-limit is failed
+        return std::vector<tripoint>();
+    }
+
+    if( d_map->expand_2d_up_to( from, route_settings ) != ExpansionOutcome::PATH_FOUND ) {
+        return std::vector<tripoint>();
+    }
+
+    return d_map->trace_route( from, d_map->dest, route_settings );
+}
+
 std::vector<tripoint> Pathfinding::get_route_3d(
     const tripoint from, const tripoint to,
     const PathfindingSettings path_settings,
@@ -1093,3 +1603,276 @@ std::vector<tripoint> Pathfinding::route(
     }
     return Pathfinding::get_route_3d( from, to, path_settings, route_settings );
 };
+
+uint64_t Pathfinding::expansion_count()
+{
+    return Pathfinding::expanded_tiles;
+}
+
+std::vector<tripoint> Pathfinding::flow_route(
+    tripoint from, const std::vector<tripoint> &dests,
+    const std::optional<tripoint> &goal,
+    const std::optional<PathfindingSettings> maybe_path_settings,
+    const std::optional<RouteSettings> maybe_route_settings )
+{
+    const map &here = get_map();
+
+    here.clip_to_bounds( from );
+
+    PathfindingSettings path_settings = maybe_path_settings.has_value() ? *maybe_path_settings :
+                                        PathfindingSettings();
+    RouteSettings route_settings = maybe_route_settings.has_value() ? *maybe_route_settings :
+                                   RouteSettings();
+
+    if( route_settings.is_relative_search_domain() ) {
+        return std::vector<tripoint>();
+    }
+
+    std::vector<point> flow_dests;
+    for( tripoint dest : dests ) {
+        here.clip_to_bounds( dest );
+        if( dest.z == from.z ) {
+            flow_dests.push_back( dest.xy() );
+        }
+    }
+    if( flow_dests.empty() ) {
+        return std::vector<tripoint>();
+    }
+
+    Pathfinding &field = Pathfinding::get_flow_field( flow_dests, from.z, path_settings );
+
+    const point start = from.xy();
+    if( field.tile_state_at( start ) != Pathfinding::State::ACCESSIBLE ) {
+        return std::vector<tripoint>();
+    }
+
+    const tripoint to = tripoint( field.flow_dests[field.flow_origin_at( start )], from.z );
+    if( goal.has_value() ) {
+        tripoint clipped_goal = *goal;
+        here.clip_to_bounds( clipped_goal );
+        if( to != clipped_goal ) {
+            return std::vector<tripoint>();
+        }
+    }
+
+    if( rl_dist_exact( from, to ) > route_settings.max_dist ) {
+        return std::vector<tripoint>();
+    }
+
+    if( from == to ) {
+        return std::vector<tripoint> { from, to };
+    }
+
+    return field.trace_route( start, to.xy(), route_settings );
+}
+
+std::shared_future<std::vector<tripoint>> Pathfinding::request_route(
+    tripoint from, tripoint to,
+    const std::optional<PathfindingSettings> maybe_path_settings,
+    const std::optional<RouteSettings> maybe_route_settings )
+{
+    const map &here = get_map();
+
+    here.clip_to_bounds( from );
+    here.clip_to_bounds( to );
+
+    PathfindingSettings path_settings = maybe_path_settings.has_value() ? *maybe_path_settings :
+                                        PathfindingSettings();
+    RouteSettings route_settings = maybe_route_settings.has_value() ? *maybe_route_settings :
+                                   RouteSettings();
+
+    std::promise<std::vector<tripoint>> result;
+    std::shared_future<std::vector<tripoint>> future = result.get_future().share();
+
+    const bool solve_now = from.z != to.z ||
+                           square_dist( from, to ) < ASYNC_MIN_DIST ||
+                           rl_dist_exact( from, to ) > route_settings.max_dist ||
+                           route_settings.is_relative_search_domain();
+    if( solve_now ) {
+        std::vector<tripoint> route = Pathfinding::route( from, to, path_settings, route_settings );
+        for( tripoint &p : route ) {
+            p = here.getabs( p );
+        }
+        result.set_value( std::move( route ) );
+        return future;
+    }
+
+    Pathfinding::route_requests.push_back( RouteJob{
+        .from = here.getabs( from ),
+        .to = here.getabs( to ),
+        .path_settings = path_settings,
+        .route_settings = route_settings,
+        .result = std::move( result ),
+        .snapshot = nullptr
+    } );
+    return future;
+}
+
+std::optional<std::vector<tripoint>> Pathfinding::collect_route(
+                                      const std::shared_future<std::vector<tripoint>> &request )
+{
+    if( !request.valid() ||
+        request.wait_for( std::chrono::seconds( 0 ) ) != std::future_status::ready ) {
+        return std::nullopt;
+    }
+
+    const map &here = get_map();
+    std::vector<tripoint> route = request.get();
+    for( tripoint &p : route ) {
+        p = here.getlocal( p );
+        if( !here.inbounds( p ) ) {
+            return std::vector<tripoint>();
+        }
+    }
+    return route;
+}
+
+void Pathfinding::dispatch_route_requests()
+{
+    std::erase_if( Pathfinding::route_workers, []( const std::future<void> &worker ) {
+        return worker.wait_for( std::chrono::seconds( 0 ) ) == std::future_status::ready;
+    } );
+
+    if( Pathfinding::route_requests.empty() ) {
+        return;
+    }
+
+    const map &here = get_map();
+    auto jobs = std::make_shared<std::vector<RouteJob>>();
+    for( RouteJob &job : Pathfinding::route_requests ) {
+        // Endpoints that left the reality bubble since the request can't be routed on this map
+        if( !here.inbounds( here.getlocal( job.from ) ) || !here.inbounds( here.getlocal( job.to ) ) ) {
+            job.result.set_value( std::vector<tripoint>() );
+        } else {
+            jobs->push_back( std::move( job ) );
+        }
+    }
+    Pathfinding::route_requests.clear();
+    if( jobs->empty() ) {
+        return;
+    }
+
+    // One snapshot for every Z level and settings jobs need
+    std::vector<std::shared_ptr<const RouteSnapshot>> snapshots;
+    for( RouteJob &job : *jobs ) {
+        PathfindingSettings settings = job.path_settings;
+        settings.mob_presence_penalty = 0;
+
+        auto snapshot_it = std::ranges::find_if( snapshots, [&settings, &job]( const auto & snapshot ) {
+            return snapshot->z == job.from.z && snapshot->settings == settings;
+        } );
+        if( snapshot_it != snapshots.end() ) {
+            job.snapshot = *snapshot_it;
+            continue;
+        }
+
+        std::shared_ptr<RouteSnapshot> snapshot = std::make_shared<RouteSnapshot>();
+        snapshot->z = job.from.z;
+        snapshot->settings = settings;
+        snapshot->origin = here.getabs( tripoint( point_zero, job.from.z ) ).xy();
+        ChunkGraph &graph = Pathfinding::get_chunk_graph( job.from.z, settings );
+        for( int chunk_y = 0; chunk_y < MAPSIZE; chunk_y++ ) {
+            for( int chunk_x = 0; chunk_x < MAPSIZE; chunk_x++ ) {
+                const Chunk &chunk = Pathfinding::get_chunk( graph, point( chunk_x, chunk_y ) );
+                for( int y = 0; y < SEEY; y++ ) {
+                    std::copy_n( &chunk.tile_costs[y * SEEX], SEEX,
+                                 &snapshot->tile_costs[( chunk_y * SEEY + y ) * MAPSIZE_X + chunk_x * SEEX] );
+                }
+            }
+        }
+        snapshots.push_back( snapshot );
+        job.snapshot = std::move( snapshot );
+    }
+
+    auto next_job = std::make_shared<std::atomic<size_t>>( 0 );
+    const auto solve_jobs = [jobs, next_job]() {
+        for( size_t i = ( *next_job )++; i < jobs->size(); i = ( *next_job )++ ) {
+            RouteJob &job = ( *jobs )[i];
+            job.result.set_value( Pathfinding::solve_route_job( job ) );
+        }
+    };
+    const size_t num_workers = std::min<size_t>( jobs->size(),
+                               std::max( 1U, std::thread::hardware_concurrency() ) );
+    for( size_t i = 0; i < num_workers; i++ ) {
+        Pathfinding::route_workers.push_back( std::async( std::launch::async, solve_jobs ) );
+    }
+}
+
+std::vector<tripoint> Pathfinding::solve_route_job( const RouteJob &job )
+{
+    using val_pair = std::pair<float, point>;
+
+    const RouteSnapshot &snapshot = *job.snapshot;
+    const point from = job.from.xy() - snapshot.origin;
+    const point to = job.to.xy() - snapshot.origin;
+    const auto inbounds = []( const point & p ) {
+        return p.x >= 0 && p.x < MAPSIZE_X && p.y >= 0 && p.y < MAPSIZE_Y;
+    };
+    // The map may have shifted (e.g. a monster dragging the player) between the request and the snapshot
+    if( !inbounds( from ) || !inbounds( to ) ) {
+        return std::vector<tripoint>();
+    }
+    const auto index = []( const point & p ) {
+        return p.y * MAPSIZE_X + p.x;
+    };
+    const auto heuristic = [&to, &job]( const point & p ) {
+        return square_dist( p, to ) * job.path_settings.move_cost_coeff;
+    };
+
+    std::vector<float> g_vals( MAPSIZE_X * MAPSIZE_Y, INFINITY );
+    std::vector<int> parents( MAPSIZE_X * MAPSIZE_Y, -1 );
+    std::priority_queue<val_pair, std::vector<val_pair>, pair_greater_cmp_first> frontier;
+
+    g_vals[index( from )] = 0.0;
+    frontier.emplace( heuristic( from ), from );
+
+    bool found = false;
+    while( !frontier.empty() ) {
+        const auto [f_val, cur] = frontier.top();
+        frontier.pop();
+        if( cur == to ) {
+            found = true;
+            break;
+        }
+        const float cur_g = g_vals[index( cur )];
+        if( f_val > cur_g + heuristic( cur ) ) {
+            // Already reached through a cheaper route
+            continue;
+        }
+
+        for( const point &dir : DIRS_2D ) {
+            const point next = cur + dir;
+            if( !inbounds( next ) ) {
+                continue;
+            }
+            // Our destination may well be an obstacle, such as a creature inside a wall
+            const float tile_cost = next == to ? 0.0f : snapshot.tile_costs[index( next )];
+            if( is_inf( tile_cost ) ) {
+                continue;
+            }
+            const bool is_diag = dir.x != 0 && dir.y != 0;
+            const float next_g = cur_g + ( is_diag ? 1.5f * tile_cost : tile_cost );
+            if( next_g < g_vals[index( next )] ) {
+                g_vals[index( next )] = next_g;
+                parents[index( next )] = index( cur );
+                frontier.emplace( next_g + heuristic( next ), next );
+            }
+        }
+    }
+
+    if( !found ) {
+        return std::vector<tripoint>();
+    }
+
+    std::vector<tripoint> result;
+    for( int i = index( to ); i != -1; i = parents[i] ) {
+        result.emplace_back( snapshot.origin + point( i % MAPSIZE_X, i / MAPSIZE_X ), snapshot.z );
+    }
+    std::ranges::reverse( result );
+
+    const float max_s = job.route_settings.max_s_coeff * square_dist( from, to );
+    if( result.size() - 2 > max_s ) {
+        return std::vector<tripoint>();
+    }
+    return result;
+}
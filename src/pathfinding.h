@@ -1,7 +1,9 @@
 #pragma once
 
 #include <array>
+#include <cstdint>
 #include <cstring>
+#include <future>
 #include <map>
 #include <memory>
 #include <optional>
@@ -14,6 +16,8 @@
 #include "point.h"
 #include "rng.h"
 
+class map;
+class vehicle;
 
 // A struct defining abilities of the actor and how to respond to various terrain features
 struct PathfindingSettings {
@@ -218,6 +222,67 @@ class Pathfinding
         // Global state: memoized dijikstra d_maps. Transfer to `d_maps_store` every game turn.
         static std::vector<std::unique_ptr<Pathfinding>> d_maps;
 
+        // Global state: memoized multi-destination flow fields. Transfer to `d_maps_store` every game turn.
+        static std::vector<std::unique_ptr<Pathfinding>> flow_fields;
+
+        // Hierarchical pathfinding splits the map into submap sized chunks, whose borders are crossed through portals.
+        // Long routes are first planned over portals, then refined with regular d_maps between consecutive portals
+        //   which only ever explore a couple chunks each.
+        struct Chunk {
+            // `map::get_pathfinding_revision` of the submap when this was built, -1 if never
+            int revision = -1;
+            // Cost of each tile [`y * SEEX + x`] as far as chunks are concerned
+            std::array<float, SEEX *SEEY> tile_costs;
+            // Border tiles [in local coords] routes go through, one in the middle of each open stretch of border
+            std::vector<point> portals;
+            // Cost of going from portal `i` to portal `j` through the chunk at `i * portals.size() + j`
+            std::vector<float> costs;
+            // For each tile of the chunk [`y * SEEX + x`] on an open stretch of border, index of its portal, otherwise -1
+            std::array<int, SEEX *SEEY> border_portal;
+            // For each tile with a `border_portal`, cost of reaching that portal from it
+            std::array<float, SEEX *SEEY> border_cost;
+        };
+        // Chunks as seen by creatures with the same `settings`
+        struct ChunkGraph {
+            int z;
+            PathfindingSettings settings;
+            // Top left submap of the map when the chunks were built
+            point abs_sub;
+            std::array<std::array<Chunk, MAPSIZE>, MAPSIZE> chunks;
+        };
+        // Global state: chunk graphs, kept across turns as long as the map doesn't change under them
+        static std::vector<std::unique_ptr<ChunkGraph>> chunk_graphs;
+
+        // Global state: total tiles expanded by d_maps
+        static uint64_t expanded_tiles;
+
+        // Tile costs of a whole Z level copied out of a chunk graph, so worker threads never have to touch the map
+        struct RouteSnapshot {
+            int z;
+            PathfindingSettings settings;
+            // Absolute position of the map's top left tile
+            point origin;
+            // Cost of each tile [`y * MAPSIZE_X + x`]
+            std::array<float, MAPSIZE_X *MAPSIZE_Y> tile_costs;
+        };
+        // A route waiting to be solved by a worker thread, in absolute coords
+        struct RouteJob {
+            tripoint from;
+            tripoint to;
+            PathfindingSettings path_settings;
+            RouteSettings route_settings;
+            std::promise<std::vector<tripoint>> result;
+            // Set when the job is handed out
+            std::shared_ptr<const RouteSnapshot> snapshot;
+        };
+        // Global state: routes requested this turn
+        static std::vector<RouteJob> route_requests;
+        // Global state: worker threads solving routes requested on previous turns
+        static std::vector<std::future<void>> route_workers;
+
+        // Solve `job` using nothing but its snapshot. Safe to call from any thread.
+        static std::vector<tripoint> solve_route_job( const RouteJob &job );
+
         // We store the area covered by last Z-scan (in global coords, top left loaded submap)
         // ```
         // -----
@@ -273,6 +338,11 @@ class Pathfinding
         // Moves we don't allow to happen
         std::set<std::pair<point, point>> forbidden_moves;
 
+        // All destinations of a flow field, which is seeded from every one of them at once. Empty for regular d_maps.
+        std::vector<point> flow_dests;
+        // Index into `flow_dests` of the destination each reached tile of a flow field leads to
+        std::vector<int> flow_origin;
+
         // Possibly shift or move all Z-changes if our `z_area` moved
         //   and scan for new changes.
         // Only process OPEN_AIR changes if `update_open_air` is true. OPEN_AIR tiles are numerous on higher Z levels
@@ -283,12 +353,28 @@ class Pathfinding
         static std::vector<ZLevelChange> &get_z_cache( const int z );
         static std::unordered_map<point, ZLevelChangeOpenAirPair> &get_z_cache_open_air( const int z );
 
+        // Pull a clean map from `d_maps_store`, allocating one if there's none
+        static std::unique_ptr<Pathfinding> take_stored_map();
         static void produce_d_map( point dest, int z, PathfindingSettings settings );
+        // Find the chunk graph for these `settings` with all its chunks in `graph.abs_sub` coords, or make it
+        static ChunkGraph &get_chunk_graph( int z, const PathfindingSettings &settings );
+        // Get chunk at `chunk_pos` [submap coords], rebuilding it first if it's outdated
+        static const Chunk &get_chunk( ChunkGraph &graph, const point &chunk_pos );
+        // Plan a route on the chunk graph and refine it, or return an empty vector if there isn't one
+        static std::vector<tripoint> get_route_hierarchical(
+            const point from, const point to, const int z,
+            const PathfindingSettings path_settings,
+            const RouteSettings route_settings );
+        // Find the flow field for these `dests`, or build it
+        static Pathfinding &get_flow_field( const std::vector<point> &dests, int z,
+                                            const PathfindingSettings &settings );
 
         // Get `p`-value at `p`
         float &p_at( const point &p );
         // Get `g`-value at `p`
         float &g_at( const point &p );
+        // Get index of the flow field destination `p` leads to
+        int &flow_origin_at( const point &p );
         // f0 = p + g
         float get_f_unbiased( const point &p );
         // f1 = p + g + `h_coeff` * [distance between `start` and `p`]
@@ -321,8 +407,21 @@ class Pathfinding
             const RouteSettings route_settings
         );
 
+        // Cost of `p` alone for chunk graphs, ignoring creatures and direction
+        float chunk_tile_cost( const map &here, const point &p );
+        // Get the g-value of `cur_point` when routing through it into adjacent `next_point`, calculating it if needed.
+        //   Returns nothing if that move is forbidden.
+        std::optional<float> step_g( const map &here, const point &cur_point, const point &next_point,
+                                     const vehicle *next_vehicle );
+
         // Continue expanding the dijikstra map until we reach `origin` or nothing remains of the frontier. Returns whether a route is present.
         ExpansionOutcome expand_2d_up_to( const point &start, const RouteSettings &route_settings );
+        // Expand a flow field from all of its destinations at once until the whole map is explored
+        void expand_flow_field();
+
+        // Walk down the cost gradient of an expanded map from `from` to `to`
+        std::vector<tripoint> trace_route( const point &from, const point &to,
+                                           const RouteSettings &route_settings );
     public:
         // get `route` from `from` to `to` if available in accordance to `route_settings` while `path_settings` defines our capabilities, otherwise empty vector.
         // Found route will include `from` and `to`.
@@ -330,9 +429,37 @@ class Pathfinding
                                             const std::optional<PathfindingSettings> path_settings = std::nullopt,
                                             const std::optional<RouteSettings> route_settings = std::nullopt );
 
+        // get `route` from `from` to whichever of `dests` is the closest to it, or an empty vector if none is reachable.
+        // Only `dests` on `from`'s Z level are considered. If `goal` is given, the route is only returned if `goal` is the closest.
+        // Every call with the same `dests` and `path_settings` within a turn shares a single flow field,
+        //   so the cost of each route is just the steps walked down the field.
+        // Relative search domains can't be shared between routes, `route` has to be used for those.
+        static std::vector<tripoint> flow_route( tripoint from, const std::vector<tripoint> &dests,
+                const std::optional<tripoint> &goal = std::nullopt,
+                const std::optional<PathfindingSettings> path_settings = std::nullopt,
+                const std::optional<RouteSettings> route_settings = std::nullopt );
+
         // Reset whole pathfinding pretty much
         static void clear_d_maps();
 
+        // Queue a route from `from` to `to` to be solved by a worker thread after `dispatch_route_requests` hands it out,
+        //   so that long routes don't hold up the turn. Get the route with `collect_route`.
+        // Workers only see this turn's terrain, creatures are left out and moves in and out of vehicles aren't checked,
+        //   so the route may need another go if it turns out to be blocked.
+        // Routes that are short, across Z levels or limited to a relative search domain are solved right away instead.
+        static std::shared_future<std::vector<tripoint>> request_route( tripoint from, tripoint to,
+                const std::optional<PathfindingSettings> path_settings = std::nullopt,
+                const std::optional<RouteSettings> route_settings = std::nullopt );
+        // get `route` for a `request_route` if it has been solved by now, otherwise nothing.
+        // Empty vector if there's no route, or if the map has moved away from it since.
+        static std::optional<std::vector<tripoint>> collect_route(
+                    const std::shared_future<std::vector<tripoint>> &request );
+        // Hand routes requested so far out to worker threads. Should be done once per turn, when the map is settled.
+        static void dispatch_route_requests();
+
+        // Total number of tiles expanded while building maps, a measure of how much work pathfinding did
+        static uint64_t expansion_count();
+
         // Reset Z-level information. Should only be done when new Z-level changes could have appeared
         //   such as change in terrain
         static void mark_dirty_z_cache();
@@ -12,13 +12,13 @@
 unsigned int rng_bits()
 {
     // Whole uint range.
-    static std::uniform_int_distribution<unsigned int> rng_uint_dist;
+    static thread_local std::uniform_int_distribution<unsigned int> rng_uint_dist;
     return rng_uint_dist( rng_get_engine() );
 }
 
 int rng( int lo, int hi )
 {
-    static std::uniform_int_distribution<int> rng_int_dist;
+    static thread_local std::uniform_int_distribution<int> rng_int_dist;
     if( lo > hi ) {
         std::swap( lo, hi );
     }
@@ -27,7 +27,7 @@ int rng( int lo, int hi )
 
 double rng_float( double lo, double hi )
 {
-    static std::uniform_real_distribution<double> rng_real_dist;
+    static thread_local std::uniform_real_distribution<double> rng_real_dist;
     if( lo > hi ) {
         std::swap( lo, hi );
     }
@@ -41,13 +41,14 @@ units::angle random_direction()
 
 double normal_roll( double mean, double stddev )
 {
-    static std::normal_distribution<double> rng_normal_dist;
+    // Per thread like the engine, since it keeps the second value of each pair it makes
+    static thread_local std::normal_distribution<double> rng_normal_dist;
     return rng_normal_dist( rng_get_engine(), std::normal_distribution<>::param_type( mean, stddev ) );
 }
 
 double exponential_roll( double lambda )
 {
-    static std::exponential_distribution<double> rng_exponential_dist;
+    static thread_local std::exponential_distribution<double> rng_exponential_dist;
     return rng_exponential_dist( rng_get_engine(),
                                  std::exponential_distribution<>::param_type( lambda ) );
 }
@@ -135,8 +136,9 @@ double rng_normal( double lo, double hi )
 
 cata_default_random_engine &rng_get_engine()
 {
+    // Per thread, so that work moved to other threads doesn't race on the main engine
     // NOLINTNEXTLINE(cata-determinism)
-    static cata_default_random_engine eng(
+    static thread_local cata_default_random_engine eng(
         std::chrono::high_resolution_clock::now().time_since_epoch().count() );
     return eng;
 }
@@ -148,6 +150,17 @@ void rng_set_engine_seed( unsigned int seed )
     }
 }
 
+rng_seed_scope::rng_seed_scope( unsigned int seed )
+    : saved( rng_get_engine() )
+{
+    rng_get_engine().seed( seed );
+}
+
+rng_seed_scope::~rng_seed_scope()
+{
+    rng_get_engine() = saved;
+}
+
 namespace weighted_list_detail
 {
 unsigned int gen_rand_i()
@@ -17,13 +17,29 @@ class tripoint_range;
 struct tripoint;
 
 // All PRNG functions use an engine, see the C++11 <random> header
-// By default, that engine is seeded by time on first call to such a function.
-// If this function is called with a non-zero seed then the engine will be
-// seeded (or re-seeded) with the given seed.
+// Each thread has its own engine, seeded by time on first call to such a function.
+// If this function is called with a non-zero seed then the calling thread's engine
+// will be seeded (or re-seeded) with the given seed.
 void rng_set_engine_seed( unsigned int seed );
 
 using cata_default_random_engine = std::minstd_rand0;
 cata_default_random_engine &rng_get_engine();
+
+/**
+ * Seeds the calling thread's engine with @p seed for the lifetime of this object,
+ * then puts back the state it had before. Rolls made in between are reproducible
+ * and leave the surrounding sequence untouched.
+ */
+class rng_seed_scope
+{
+    public:
+        explicit rng_seed_scope( unsigned int seed );
+        ~rng_seed_scope();
+        rng_seed_scope( const rng_seed_scope & ) = delete;
+        rng_seed_scope &operator=( const rng_seed_scope & ) = delete;
+    private:
+        cata_default_random_engine saved;
+};
 unsigned int rng_bits();
 
 int rng( int lo, int hi );
@@ -1292,11 +1292,13 @@ void Creature_tracker::serialize( JsonOut &jsout ) const
 
 void overmapbuffer::serialize_placed_unique_specials( JsonOut &json ) const
 {
+    std::lock_guard<std::mutex> _ul( placed_unique_specials_mutex );
     json.write_as_array( placed_unique_specials );
 }
 
 void overmapbuffer::deserialize_placed_unique_specials( JsonIn &jsin )
 {
+    std::lock_guard<std::mutex> _ul( placed_unique_specials_mutex );
     placed_unique_specials.clear();
     jsin.start_array();
     while( !jsin.end_array() ) {
@@ -3272,7 +3272,8 @@ struct mm_elem {
     }
 };
 
-void mm_submap::serialize( JsonOut &jsout ) const
+void mm_submap::serialize( JsonOut &jsout,
+                           const std::unordered_map<memorized_tile_id, int> &indices ) const
 {
     jsout.start_array();
 
@@ -3283,7 +3284,7 @@ void mm_submap::serialize( JsonOut &jsout ) const
 
     const auto write_seq = [&]() {
         jsout.start_array();
-        jsout.write( last.tile.tile );
+        jsout.write( indices.at( last.tile.tile ) );
         jsout.write( last.tile.subtile );
         jsout.write( last.tile.rotation );
         jsout.write( last.symbol );
@@ -3315,7 +3316,7 @@ void mm_submap::serialize( JsonOut &jsout ) const
     jsout.end_array();
 }
 
-void mm_submap::deserialize( JsonIn &jsin )
+void mm_submap::deserialize( JsonIn &jsin, const std::vector<memorized_tile_id> *table )
 {
     jsin.start_array();
 
@@ -3330,7 +3331,15 @@ void mm_submap::deserialize( JsonIn &jsin )
                 remaining -= 1;
             } else {
                 jsin.start_array();
-                elem.tile.tile = jsin.get_string();
+                if( table == nullptr ) {
+                    elem.tile.tile = memorized_tile_id( jsin.get_string() );
+                } else {
+                    const int index = jsin.get_int();
+                    if( index < 0 || static_cast<size_t>( index ) >= table->size() ) {
+                        jsin.error( "memorized tile index out of range" );
+                    }
+                    elem.tile.tile = ( *table )[index];
+                }
                 elem.tile.subtile = jsin.get_int();
                 elem.tile.rotation = jsin.get_int();
                 elem.symbol = jsin.get_int();
@@ -3354,6 +3363,31 @@ void mm_submap::deserialize( JsonIn &jsin )
 
 void mm_region::serialize( JsonOut &jsout ) const
 {
+    // Each region file has its own string table, so it can be read on its own.
+    std::vector<memorized_tile_id> table;
+    std::unordered_map<memorized_tile_id, int> indices;
+    for( const auto &column : submaps ) {
+        for( const shared_ptr_fast<mm_submap> &sm : column ) {
+            for( const memorized_terrain_tile &t : sm->tiles ) {
+                if( indices.emplace( t.tile, table.size() ).second ) {
+                    table.push_back( t.tile );
+                }
+            }
+        }
+    }
+    // Submaps with symbols but no tiles write the default tile.
+    if( indices.emplace( mm_submap::default_tile.tile, table.size() ).second ) {
+        table.push_back( mm_submap::default_tile.tile );
+    }
+
+    jsout.start_object();
+    jsout.member( "tiles" );
+    jsout.start_array();
+    for( const memorized_tile_id &id : table ) {
+        jsout.write( id.str() );
+    }
+    jsout.end_array();
+    jsout.member( "submaps" );
     jsout.start_array();
     // NOLINTNEXTLINE(modernize-loop-convert): leaving as is for readability
     for( size_t y = 0; y < MM_REG_SIZE; y++ ) {
@@ -3363,15 +3397,33 @@ void mm_region::serialize( JsonOut &jsout ) const
             if( sm->is_empty() ) {
                 jsout.write_null();
             } else {
-                sm->serialize( jsout );
+                sm->serialize( jsout, indices );
             }
         }
     }
     jsout.end_array();
+    jsout.end_object();
 }
 
 void mm_region::deserialize( JsonIn &jsin )
 {
+    std::vector<memorized_tile_id> table;
+    const bool has_table = jsin.test_object();
+    if( has_table ) {
+        jsin.start_object();
+        if( jsin.get_member_name() != "tiles" ) {
+            jsin.error( "expected the string table first" );
+        }
+        jsin.start_array();
+        while( !jsin.end_array() ) {
+            table.emplace_back( jsin.get_string() );
+        }
+        if( jsin.get_member_name() != "submaps" ) {
+            jsin.error( "expected submaps after the string table" );
+        }
+    }
+    // Older saves are just the array of submaps, with the tile ids inline.
+
     jsin.start_array();
     // NOLINTNEXTLINE(modernize-loop-convert): leaving as is for readability
     for( size_t y = 0; y < MM_REG_SIZE; y++ ) {
@@ -3382,11 +3434,15 @@ void mm_region::deserialize( JsonIn &jsin )
             if( jsin.test_null() ) {
                 jsin.skip_null();
             } else {
-                sm->deserialize( jsin );
+                sm->deserialize( jsin, has_table ? &table : nullptr );
             }
         }
     }
     jsin.end_array();
+
+    if( has_table ) {
+        jsin.end_object();
+    }
 }
 
 void map_memory::load_legacy( JsonIn &jsin )
@@ -3406,7 +3462,7 @@ void map_memory::load_legacy( JsonIn &jsin )
         p.y = jsin.get_int();
         p.z = jsin.get_int();
         mig_elem &elem = elems[p];
-        elem.tile.tile = jsin.get_string();
+        elem.tile.tile = memorized_tile_id( jsin.get_string() );
         elem.tile.subtile = jsin.get_int();
         elem.tile.rotation = jsin.get_int();
         jsin.end_array();
@@ -3689,9 +3745,6 @@ void stats_tracker::deserialize( JsonIn &jsin )
 
 void submap::store( JsonOut &jsout ) const
 {
-    jsout.member( "turn_last_touched", last_touched );
-    jsout.member( "temperature", temperature );
-
     // Terrain is saved using a simple RLE scheme.  Legacy saves don't have
     // this feature but the algorithm is backward compatible.
     jsout.member( "terrain" );
@@ -3777,20 +3830,6 @@ void submap::store( JsonOut &jsout ) const
     }
     jsout.end_array();
 
-    jsout.member( "items" );
-    jsout.start_array();
-    for( int j = 0; j < SEEY; j++ ) {
-        for( int i = 0; i < SEEX; i++ ) {
-            if( itm[i][j].empty() ) {
-                continue;
-            }
-            jsout.write( i );
-            jsout.write( j );
-            jsout.write( itm[i][j] );
-        }
-    }
-    jsout.end_array();
-
     jsout.member( "traps" );
     jsout.start_array();
     for( int j = 0; j < SEEY; j++ ) {
@@ -3809,6 +3848,28 @@ void submap::store( JsonOut &jsout ) const
     }
     jsout.end_array();
 
+    store_contents( jsout );
+}
+
+void submap::store_contents( JsonOut &jsout ) const
+{
+    jsout.member( "turn_last_touched", last_touched );
+    jsout.member( "temperature", temperature );
+
+    jsout.member( "items" );
+    jsout.start_array();
+    for( int j = 0; j < SEEY; j++ ) {
+        for( int i = 0; i < SEEX; i++ ) {
+            if( itm[i][j].empty() ) {
+                continue;
+            }
+            jsout.write( i );
+            jsout.write( j );
+            jsout.write( itm[i][j] );
+        }
+    }
+    jsout.end_array();
+
     jsout.member( "fields" );
     jsout.start_array();
     for( int j = 0; j < SEEY; j++ ) {
@@ -3954,7 +4015,7 @@ void submap::load( JsonIn &jsin, const std::string &member_name, int version,
             int rad_num = jsin.get_int();
             for( int i = 0; i < rad_num; ++i ) {
                 if( rad_cell < SEEX * SEEY ) {
-                    set_radiation( { 0 % SEEX, rad_cell / SEEX }, rad_strength );
+                    set_radiation( { rad_cell % SEEX, rad_cell / SEEX }, rad_strength );
                     rad_cell++;
                 }
             }
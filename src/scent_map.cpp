@@ -3,6 +3,8 @@
 #include <algorithm>
 #include <cassert>
 #include <cstdlib>
+#include <memory>
+#include <vector>
 
 #include "assign.h"
 #include "calendar.h"
@@ -13,6 +15,7 @@
 #include "game.h"
 #include "generic_factory.h"
 #include "map.h"
+#include "options.h"
 #include "output.h"
 #include "string_id.h"
 
@@ -56,14 +59,21 @@ void scent_map::reset()
         }
     }
     typescent = scenttype_id();
+    layers.clear();
 }
 
 void scent_map::decay()
 {
-    for( auto &elem : grscent ) {
-        for( auto &val : elem ) {
-            val = std::max( 0, val - 1 );
+    const auto decay_layer = []( scent_array<int> &scent ) {
+        for( auto &elem : scent ) {
+            for( auto &val : elem ) {
+                val = std::max( 0, val - 1 );
+            }
         }
+    };
+    decay_layer( grscent );
+    for( auto &layer : layers ) {
+        decay_layer( *layer.second );
     }
 }
 
@@ -81,14 +91,20 @@ void scent_map::draw( const catacurses::window &win, const int div, const tripoi
 
 void scent_map::shift( point sm_shift )
 {
-    scent_array<int> new_scent;
-    for( size_t x = 0; x < MAPSIZE_X; ++x ) {
-        for( size_t y = 0; y < MAPSIZE_Y; ++y ) {
-            const point p = point( x, y ) + sm_shift;
-            new_scent[x][y] = inbounds( p ) ? grscent[ p.x ][ p.y ] : 0;
+    const auto shift_layer = [&]( scent_array<int> &scent ) {
+        scent_array<int> new_scent;
+        for( size_t x = 0; x < MAPSIZE_X; ++x ) {
+            for( size_t y = 0; y < MAPSIZE_Y; ++y ) {
+                const point p = point( x, y ) + sm_shift;
+                new_scent[x][y] = inbounds( p ) ? scent[ p.x ][ p.y ] : 0;
+            }
         }
+        scent = new_scent;
+    };
+    shift_layer( grscent );
+    for( auto &layer : layers ) {
+        shift_layer( *layer.second );
     }
-    grscent = new_scent;
 }
 
 int scent_map::get( const tripoint &p ) const
@@ -111,6 +127,16 @@ void scent_map::set_unsafe( const tripoint &p, int value, const scenttype_id &ty
     grscent[p.x][p.y] = value;
     if( !type.is_empty() ) {
         typescent = type;
+        if( get_option<bool>( "SCENT_LAYERS" ) ) {
+            std::unique_ptr<scent_array<int>> &layer = layers[type];
+            if( !layer ) {
+                layer = std::make_unique<scent_array<int>>();
+                for( auto &elem : *layer ) {
+                    elem.fill( 0 );
+                }
+            }
+            ( *layer )[p.x][p.y] = value;
+        }
     }
 }
 int scent_map::get_unsafe( const tripoint &p ) const
@@ -123,6 +149,14 @@ scenttype_id scent_map::get_type( const tripoint &p ) const
     scenttype_id id;
     if( inbounds( p ) && grscent[p.x][p.y] > 0 ) {
         id = typescent;
+        int strongest = 0;
+        for( const auto &layer : layers ) {
+            const int value = ( *layer.second )[p.x][p.y];
+            if( value > strongest ) {
+                strongest = value;
+                id = layer.first;
+            }
+        }
     }
     return id;
 }
@@ -147,6 +181,72 @@ bool scent_map::inbounds( const tripoint &p ) const
 
     return scent_map_boundaries.contains( p.xy() );
 }
+// Diffusion works on the square of SCENT_RADIUS around the center
+static constexpr int SCENT_SIZE = SCENT_RADIUS * 2 + 1;
+
+using scent_grid = std::array<std::array<int, MAPSIZE_Y>, MAPSIZE_X>;
+using transfer_grid = std::array<std::array<char, MAPSIZE_Y>, MAPSIZE_X>;
+// Indexed [x][y] from the corner of the diffusion square, so that columns are contiguous
+template<typename T, size_t W>
+using scent_columns = std::array<std::array<T, SCENT_SIZE>, W>;
+
+// A diagonal a vehicle keeps scent from crossing
+struct scent_hole {
+    // Square in the diffusion square
+    point square;
+    // Absolute square the scent doesn't come from
+    point from;
+};
+
+// Diffuse one layer of scent, with the terrain side of things worked out beforehand.
+// All but the last pass work on whole columns at a time, which the compiler turns into vector code.
+static void diffuse_scent( scent_grid &scent, const transfer_grid &scent_transfer,
+                           point min, const scent_columns<int, SCENT_SIZE> &squares_used,
+                           const std::vector<scent_hole> &holes )
+{
+    // Scent of the 3 squares above and below, of every column plus one on either side
+    scent_columns<int, SCENT_SIZE + 2> sum_3_scent_y;
+    for( int x = 0; x < SCENT_SIZE + 2; ++x ) {
+        const int abs_x = min.x - 1 + x;
+        std::array<int, SCENT_SIZE + 2> weighted;
+        const int *const column = &scent[abs_x][min.y - 1];
+        const char *const transfer = &scent_transfer[abs_x][min.y - 1];
+        for( int y = 0; y < SCENT_SIZE + 2; ++y ) {
+            weighted[y] = transfer[y] * column[y];
+        }
+        for( int y = 0; y < SCENT_SIZE; ++y ) {
+            sum_3_scent_y[x][y] = weighted[y] + weighted[y + 1] + weighted[y + 2];
+        }
+    }
+
+    scent_columns<int, SCENT_SIZE> total;
+    for( int x = 0; x < SCENT_SIZE; ++x ) {
+        for( int y = 0; y < SCENT_SIZE; ++y ) {
+            total[x][y] = sum_3_scent_y[x][y] + sum_3_scent_y[x + 1][y] + sum_3_scent_y[x + 2][y];
+        }
+    }
+    for( const scent_hole &hole : holes ) {
+        total[hole.square.x][hole.square.y] -= 4 * scent[hole.from.x][hole.from.y];
+    }
+
+    scent_columns<int, SCENT_SIZE> new_scent;
+    for( int x = 0; x < SCENT_SIZE; ++x ) {
+        const int *const column = &scent[min.x + x][min.y];
+        const char *const transfer = &scent_transfer[min.x + x][min.y];
+        for( int y = 0; y < SCENT_SIZE; ++y ) {
+            const int used = squares_used[x][y];
+            //Lingering scent
+            int temp_scent = column[y] * ( 250 - used * transfer[y] );
+            temp_scent -= column[y] * transfer[y] * ( 45 - used ) / 5;
+
+            new_scent[x][y] = ( temp_scent + total[x][y] * transfer[y] ) / 250;
+        }
+    }
+    for( int x = 0; x < SCENT_SIZE; ++x ) {
+        std::copy( new_scent[x].begin(), new_scent[x].end(), &scent[min.x + x][min.y] );
+    }
+}
+
 void scent_map::update( const tripoint &center, map &m )
 {
     // Stop updating scent after X turns of the player not moving.
@@ -158,88 +258,61 @@ void scent_map::update( const tripoint &center, map &m )
         return;
     }
 
+    if( !layers.empty() && !get_option<bool>( "SCENT_LAYERS" ) ) {
+        layers.clear();
+    }
+
     //the block and reduce scent properties are folded into a single scent_transfer value here
     //block=0 reduce=1 normal=5
     scent_array<char> scent_transfer;
 
-    std::array < std::array < int, 3 + SCENT_RADIUS * 2 >, 1 + SCENT_RADIUS * 2 > new_scent;
-    std::array < std::array < int, 3 + SCENT_RADIUS * 2 >, 1 + SCENT_RADIUS * 2 > sum_3_scent_y;
-    std::array < std::array < char, 3 + SCENT_RADIUS * 2 >, 1 + SCENT_RADIUS * 2 > squares_used_y;
-
     diagonal_blocks( &blocked_cache )[MAPSIZE_X][MAPSIZE_Y] = m.access_cache(
                 center.z ).vehicle_obstructed_cache;
 
     // for loop constants
-    const int scentmap_minx = center.x - SCENT_RADIUS;
-    const int scentmap_maxx = center.x + SCENT_RADIUS;
-    const int scentmap_miny = center.y - SCENT_RADIUS;
-    const int scentmap_maxy = center.y + SCENT_RADIUS;
+    const point min( center.x - SCENT_RADIUS, center.y - SCENT_RADIUS );
+    const point max( center.x + SCENT_RADIUS, center.y + SCENT_RADIUS );
 
     // The new scent flag searching function. Should be wayyy faster than the old one.
-    m.scent_blockers( scent_transfer, point( scentmap_minx - 1, scentmap_miny - 1 ),
-                      point( scentmap_maxx + 1, scentmap_maxy + 1 ) );
-
-    for( int x = 0; x < SCENT_RADIUS * 2 + 3; ++x ) {
-        sum_3_scent_y[0][x] = 0;
-        squares_used_y[0][x] = 0;
-        sum_3_scent_y[SCENT_RADIUS * 2][x] = 0;
-        squares_used_y[SCENT_RADIUS * 2][x] = 0;
+    m.scent_blockers( scent_transfer, min - point_south_east, max + point_south_east );
+
+    // How much scent every square of the diffusion square lets through, the same for every layer
+    scent_columns<char, SCENT_SIZE + 2> squares_used_y;
+    for( int x = 0; x < SCENT_SIZE + 2; ++x ) {
+        const char *const transfer = &scent_transfer[min.x - 1 + x][min.y - 1];
+        for( int y = 0; y < SCENT_SIZE; ++y ) {
+            squares_used_y[x][y] = transfer[y] + transfer[y + 1] + transfer[y + 2];
+        }
     }
-
-    for( int x = 0; x < SCENT_RADIUS * 2 + 3; ++x ) {
-        for( int y = 0; y < SCENT_RADIUS * 2 + 1; ++y ) {
-
-            point abs( x + scentmap_minx - 1, y + scentmap_miny );
-
-            // remember the sum of the scent val for the 3 neighboring squares that can defuse into
-            sum_3_scent_y[y][x] = 0;
-            squares_used_y[y][x] = 0;
-            for( int i = abs.y - 1; i <= abs.y + 1; ++i ) {
-                sum_3_scent_y[y][x] += scent_transfer[abs.x][i] * grscent[abs.x][i];
-                squares_used_y[y][x] += scent_transfer[abs.x][i];
-            }
+    scent_columns<int, SCENT_SIZE> squares_used;
+    for( int x = 0; x < SCENT_SIZE; ++x ) {
+        for( int y = 0; y < SCENT_SIZE; ++y ) {
+            squares_used[x][y] = squares_used_y[x][y] + squares_used_y[x + 1][y] + squares_used_y[x + 2][y];
         }
     }
 
-    for( int x = 1; x < SCENT_RADIUS * 2 + 2; ++x ) {
-        for( int y = 0; y < SCENT_RADIUS * 2 + 1; ++y ) {
-            const point abs( x + scentmap_minx - 1, y + scentmap_miny );
-
-            int squares_used = squares_used_y[y][x - 1] + squares_used_y[y][x] + squares_used_y[y][x + 1];
-            int total = sum_3_scent_y[y][x - 1] + sum_3_scent_y[y][x] + sum_3_scent_y[y][x + 1];
-
-            //handle vehicle holes
-            if( blocked_cache[abs.x][abs.y].nw && scent_transfer[abs.x + 1][abs.y + 1] == 5 ) {
-                squares_used -= 4;
-                total -= 4 * grscent[abs.x + 1][abs.y + 1];
-            }
-            if( blocked_cache[abs.x][abs.y].ne && scent_transfer[abs.x - 1][abs.y + 1] == 5 ) {
-                squares_used -= 4;
-                total -= 4 * grscent[abs.x - 1][abs.y + 1];
-            }
-            if( blocked_cache[abs.x - 1][abs.y - 1].nw && scent_transfer[abs.x - 1][abs.y - 1] == 5 ) {
-                squares_used -= 4;
-                total -= 4 * grscent[abs.x - 1][abs.y - 1];
-            }
-            if( blocked_cache[abs.x + 1][abs.y - 1].ne && scent_transfer[abs.x + 1][abs.y - 1] == 5 ) {
-                squares_used -= 4;
-                total -= 4 * grscent[abs.x + 1][abs.y - 1];
-            }
-
-            //Lingering scent
-            int temp_scent =  grscent[abs.x][abs.y] * ( 250 - squares_used  *
-                              scent_transfer[abs.x][abs.y] ) ;
-            temp_scent -=  grscent[abs.x][abs.y] * scent_transfer[abs.x][abs.y] *
-                           ( 45 - squares_used ) / 5;
-
-            new_scent[y][x] = ( temp_scent + total * scent_transfer[abs.x][abs.y] ) / 250;
-
+    //handle vehicle holes
+    std::vector<scent_hole> holes;
+    for( int x = 0; x < SCENT_SIZE; ++x ) {
+        for( int y = 0; y < SCENT_SIZE; ++y ) {
+            const point abs = min + point( x, y );
+            const point square( x, y );
+            const auto add_hole = [&]( bool blocked, point from ) {
+                if( blocked && scent_transfer[from.x][from.y] == 5 ) {
+                    squares_used[x][y] -= 4;
+                    holes.push_back( { square, from } );
+                }
+            };
+            add_hole( blocked_cache[abs.x][abs.y].nw, abs + point_south_east );
+            add_hole( blocked_cache[abs.x][abs.y].ne, abs + point_south_west );
+            add_hole( blocked_cache[abs.x - 1][abs.y - 1].nw, abs + point_north_west );
+            add_hole( blocked_cache[abs.x + 1][abs.y - 1].ne, abs + point_north_east );
         }
     }
-    for( int x = 1; x < SCENT_RADIUS * 2 + 2; ++x ) {
-        for( int y = 0; y < SCENT_RADIUS * 2 + 1; ++y ) {
-            grscent[x + scentmap_minx - 1 ][y + scentmap_miny] = new_scent[y][x];
-        }
+
+    diffuse_scent( grscent, scent_transfer, min, squares_used, holes );
+    for( auto &layer : layers ) {
+        diffuse_scent( *layer.second, scent_transfer, min, squares_used, holes );
     }
 }
 
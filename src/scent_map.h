@@ -1,6 +1,8 @@
 #pragma once
 
 #include <array>
+#include <map>
+#include <memory>
 #include <optional>
 #include <set>
 #include <string>
@@ -45,6 +47,12 @@ class scent_map
 
         scent_array<int> grscent;
         scenttype_id typescent;
+        /**
+         * With the SCENT_LAYERS option, every type of scent also spreads on its own layer,
+         * so that @ref get_type can tell which one is strongest at any position
+         * instead of going by whichever was set last. Layers aren't saved.
+         */
+        std::map<scenttype_id, std::unique_ptr<scent_array<int>>> layers;
         std::optional<tripoint> player_last_position;
         time_point player_last_moved = calendar::before_time_starts;
 
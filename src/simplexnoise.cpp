@@ -17,6 +17,7 @@
 
 #include "simplexnoise.h"
 
+#include <algorithm>
 #include <cmath>
 #include <numbers>
 
@@ -533,6 +534,120 @@ float raw_noise_4d( const float x, const float y, const float z, const float w )
     return 27.0f * ( n0 + n1 + n2 + n3 + n4 );
 }
 
+void raw_noise_3d_lanes( const float *x, const float *y, const float *z, float *out )
+{
+    // Same steps as raw_noise_3d, one array entry per point.
+    constexpr float F3 = 1.0f / 3.0f;
+    constexpr float G3 = 1.0f / 6.0f;
+
+    int i[noise_lanes];
+    int j[noise_lanes];
+    int k[noise_lanes];
+    float x0[noise_lanes];
+    float y0[noise_lanes];
+    float z0[noise_lanes];
+    for( int l = 0; l < noise_lanes; l++ ) {
+        const float s = ( x[l] + y[l] + z[l] ) * F3;
+        i[l] = fastfloor( x[l] + s );
+        j[l] = fastfloor( y[l] + s );
+        k[l] = fastfloor( z[l] + s );
+        const float t = ( i[l] + j[l] + k[l] ) * G3;
+        x0[l] = x[l] - ( i[l] - t );
+        y0[l] = y[l] - ( j[l] - t );
+        z0[l] = z[l] - ( k[l] - t );
+    }
+
+    // The simplex corner offsets, picked the same way as the branches in raw_noise_3d.
+    int i1[noise_lanes];
+    int j1[noise_lanes];
+    int k1[noise_lanes];
+    int i2[noise_lanes];
+    int j2[noise_lanes];
+    int k2[noise_lanes];
+    for( int l = 0; l < noise_lanes; l++ ) {
+        const bool xy = x0[l] >= y0[l];
+        const bool yz = y0[l] >= z0[l];
+        const bool xz = x0[l] >= z0[l];
+        i1[l] = xy && ( yz || xz );
+        j1[l] = !xy && yz;
+        k1[l] = !yz && ( !xy || !xz );
+        i2[l] = xy || ( yz && xz );
+        j2[l] = !xy || yz;
+        k2[l] = xy ? !yz : !( yz && xz );
+    }
+
+    int gi0[noise_lanes];
+    int gi1[noise_lanes];
+    int gi2[noise_lanes];
+    int gi3[noise_lanes];
+    for( int l = 0; l < noise_lanes; l++ ) {
+        const int ii = i[l] & 255;
+        const int jj = j[l] & 255;
+        const int kk = k[l] & 255;
+        gi0[l] = perm[ii + perm[jj + perm[kk]]] % 12;
+        gi1[l] = perm[ii + i1[l] + perm[jj + j1[l] + perm[kk + k1[l]]]] % 12;
+        gi2[l] = perm[ii + i2[l] + perm[jj + j2[l] + perm[kk + k2[l]]]] % 12;
+        gi3[l] = perm[ii + 1 + perm[jj + 1 + perm[kk + 1]]] % 12;
+    }
+
+    const auto corner = []( const int gi, const float cx, const float cy, const float cz ) {
+        float t = 0.6f - cx * cx - cy * cy - cz * cz;
+        t *= t;
+        const float n = t * t * dot( grad3[gi], cx, cy, cz );
+        return 0.6f - cx * cx - cy * cy - cz * cz < 0 ? 0.0f : n;
+    };
+    for( int l = 0; l < noise_lanes; l++ ) {
+        const float n0 = corner( gi0[l], x0[l], y0[l], z0[l] );
+        const float n1 = corner( gi1[l], x0[l] - i1[l] + G3, y0[l] - j1[l] + G3, z0[l] - k1[l] + G3 );
+        const float n2 = corner( gi2[l], x0[l] - i2[l] + 2.0f * G3, y0[l] - j2[l] + 2.0f * G3,
+                                 z0[l] - k2[l] + 2.0f * G3 );
+        const float n3 = corner( gi3[l], x0[l] - 1.0f + 3.0f * G3, y0[l] - 1.0f + 3.0f * G3,
+                                 z0[l] - 1.0f + 3.0f * G3 );
+        out[l] = 32.0f * ( n0 + n1 + n2 + n3 );
+    }
+}
+
+void scaled_octave_noise_3d_grid( const float octaves, const float persistence,
+                                  const float scale, const float loBound, const float hiBound, const float x, const float y,
+                                  const float z, const int width, const int height, float *out )
+{
+    const int count = width * height;
+    std::fill( out, out + count, 0.0f );
+
+    float frequency = scale;
+    float amplitude = 1;
+    float maxAmplitude = 0;
+
+    for( int octave = 0; octave < octaves; octave++ ) {
+        for( int first = 0; first < count; first += noise_lanes ) {
+            float px[noise_lanes];
+            float py[noise_lanes];
+            float pz[noise_lanes];
+            float n[noise_lanes];
+            for( int l = 0; l < noise_lanes; l++ ) {
+                // lanes past the end repeat the last point
+                const int index = std::min( first + l, count - 1 );
+                px[l] = ( x + static_cast<float>( index / height ) ) * frequency;
+                py[l] = ( y + static_cast<float>( index % height ) ) * frequency;
+                pz[l] = z * frequency;
+            }
+            raw_noise_3d_lanes( px, py, pz, n );
+            const int lanes = std::min( noise_lanes, count - first );
+            for( int l = 0; l < lanes; l++ ) {
+                out[first + l] += n[l] * amplitude;
+            }
+        }
+
+        frequency *= 2;
+        maxAmplitude += amplitude;
+        amplitude *= persistence;
+    }
+
+    for( int index = 0; index < count; index++ ) {
+        out[index] = out[index] / maxAmplitude * ( hiBound - loBound ) / 2 + ( hiBound + loBound ) / 2;
+    }
+}
+
 int fastfloor( const float x )
 {
     return x > 0 ? static_cast<int>( x ) : static_cast<int>( x ) - 1;
@@ -114,6 +114,27 @@ float raw_noise_2d( float x, float y );
 float raw_noise_3d( float x, float y, float z );
 float raw_noise_4d( float x, float y, float, float w );
 
+// Number of points raw_noise_3d_lanes works on at once.
+constexpr int noise_lanes = 8;
+
+// Raw Simplex noise for noise_lanes points at once, with the same results as raw_noise_3d.
+// Branches are replaced by selects so the compiler can vectorize the lanes.
+void raw_noise_3d_lanes( const float *x, const float *y, const float *z, float *out );
+
+// Scaled Multi-octave Simplex noise for a whole grid of points.
+// out[i * height + j] is the noise at (x + i, y + j, z), for i < width and j < height.
+void scaled_octave_noise_3d_grid( float octaves,
+                                  float persistence,
+                                  float scale,
+                                  float loBound,
+                                  float hiBound,
+                                  float x,
+                                  float y,
+                                  float z,
+                                  int width,
+                                  int height,
+                                  float *out );
+
 int fastfloor( float x );
 
 float dot( const int *g, float x, float y );
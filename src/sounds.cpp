@@ -2,11 +2,14 @@
 
 #include <algorithm>
 #include <chrono>
+#include <climits>
 #include <cmath>
 #include <cstdlib>
+#include <map>
 #include <memory>
 #include <optional>
 #include <ostream>
+#include <queue>
 #include <set>
 #include <system_error>
 #include <type_traits>
@@ -18,6 +21,7 @@
 #include "calendar.h"
 #include "coordinate_conversions.h"
 #include "creature.h"
+#include "creature_tracker.h"
 #include "debug.h"
 #include "effect.h"
 #include "enums.h"
@@ -26,12 +30,14 @@
 #include "game_constants.h"
 #include "item.h"
 #include "itype.h"
+#include "lightmap.h"
 #include "line.h"
 #include "map.h"
 #include "map_iterator.h"
 #include "messages.h"
 #include "monster.h"
 #include "npc.h"
+#include "options.h"
 #include "overmapbuffer.h"
 #include "player.h"
 #include "player_activity.h"
@@ -339,10 +345,114 @@ static int get_signal_for_hordes( const centroid &centr )
     return 0;
 }
 
-void sounds::process_sounds()
+// Sounds are spread over a grid of cells this many tiles wide
+static constexpr int SOUND_CELL_SIZE = 4;
+static constexpr int SOUND_GRID_X = ( MAPSIZE_X + SOUND_CELL_SIZE - 1 ) / SOUND_CELL_SIZE;
+static constexpr int SOUND_GRID_Y = ( MAPSIZE_Y + SOUND_CELL_SIZE - 1 ) / SOUND_CELL_SIZE;
+// Crossing a cell of solid terrain counts as this many times the distance
+static constexpr int SOUND_WALL_ATTENUATION = 5;
+
+static point sound_cell( const tripoint &p )
 {
-    ZoneScoped;
+    return point( std::clamp( p.x / SOUND_CELL_SIZE, 0, SOUND_GRID_X - 1 ),
+                  std::clamp( p.y / SOUND_CELL_SIZE, 0, SOUND_GRID_Y - 1 ) );
+}
+
+// The loudest sound reaching a cell of the sound grid
+struct heard_sound {
+    tripoint source;
+    int volume = 0;
+    int distance = 0;
+
+    bool louder_than( const heard_sound &other ) const {
+        return volume - distance > other.volume - other.distance;
+    }
+};
+
+class sound_grid
+{
+    public:
+        sound_grid() : cells( static_cast<size_t>( SOUND_GRID_X ) * SOUND_GRID_Y * OVERMAP_LAYERS ) {}
+
+        void add( const heard_sound &heard, const point &cell, int z ) {
+            std::optional<heard_sound> &loudest = cells[index( cell, z )];
+            if( !loudest || heard.louder_than( *loudest ) ) {
+                loudest = heard;
+            }
+        }
+        const std::optional<heard_sound> &at( const tripoint &p ) const {
+            return cells[index( sound_cell( p ), p.z )];
+        }
+
+    private:
+        std::vector<std::optional<heard_sound>> cells;
+
+        static size_t index( const point &cell, int z ) {
+            return ( static_cast<size_t>( z + OVERMAP_DEPTH ) * SOUND_GRID_Y + cell.y ) * SOUND_GRID_X + cell.x;
+        }
+};
+
+static tripoint sound_cell_center( const point &cell, int z )
+{
+    return tripoint( cell * SOUND_CELL_SIZE + point( SOUND_CELL_SIZE / 2, SOUND_CELL_SIZE / 2 ), z );
+}
 
+// How much further sound has to travel to get through each cell, going by what blocks light
+static std::vector<int> sound_cell_costs( int z )
+{
+    const level_cache &cache = get_map().get_cache_ref( z );
+    std::vector<int> costs( SOUND_GRID_X * SOUND_GRID_Y, 0 );
+    for( int x = 0; x < MAPSIZE_X; x++ ) {
+        for( int y = 0; y < MAPSIZE_Y; y++ ) {
+            if( cache.transparency_cache[x][y] <= LIGHT_TRANSPARENCY_SOLID ) {
+                costs[( y / SOUND_CELL_SIZE ) * SOUND_GRID_X + x / SOUND_CELL_SIZE]++;
+            }
+        }
+    }
+    const int cell_area = SOUND_CELL_SIZE * SOUND_CELL_SIZE;
+    for( int &cost : costs ) {
+        cost = SOUND_CELL_SIZE + SOUND_CELL_SIZE * ( SOUND_WALL_ATTENUATION - 1 ) * cost / cell_area;
+    }
+    return costs;
+}
+
+// Spread the sound over its own Z level around walls, cell by cell.
+// Returns the distance the sound travelled to every cell, INT_MAX where it didn't get to.
+static std::vector<int> spread_sound_around_walls( sound_grid &grid, const tripoint &source,
+        int vol, const std::vector<int> &costs )
+{
+    using dist_cell = std::pair<int, point>;
+    std::vector<int> dists( SOUND_GRID_X * SOUND_GRID_Y, INT_MAX );
+    std::priority_queue<dist_cell, std::vector<dist_cell>, std::greater<>> frontier;
+    const point start = sound_cell( source );
+    dists[start.y * SOUND_GRID_X + start.x] = sound_distance( source,
+            sound_cell_center( start, source.z ) );
+    frontier.emplace( dists[start.y * SOUND_GRID_X + start.x], start );
+    while( !frontier.empty() ) {
+        const auto [dist, cell] = frontier.top();
+        frontier.pop();
+        if( dist > dists[cell.y * SOUND_GRID_X + cell.x] ) {
+            continue;
+        }
+        grid.add( heard_sound{ source, vol, dist }, cell, source.z );
+        for( const point &dir : eight_adjacent_offsets ) {
+            const point next = cell + dir;
+            if( next.x < 0 || next.x >= SOUND_GRID_X || next.y < 0 || next.y >= SOUND_GRID_Y ) {
+                continue;
+            }
+            const int next_dist = dist + costs[next.y * SOUND_GRID_X + next.x];
+            if( next_dist < vol * 2 && next_dist < dists[next.y * SOUND_GRID_X + next.x] ) {
+                dists[next.y * SOUND_GRID_X + next.x] = next_dist;
+                frontier.emplace( next_dist, next );
+            }
+        }
+    }
+    return dists;
+}
+
+// Apply the sounds to monsters by way of the centroids of clustered sounds
+static void process_sound_clusters()
+{
     std::vector<centroid> sound_clusters = cluster_sounds( recent_sounds );
     const int weather_vol = get_weather().weather_id->sound_attn;
     for( const auto &this_centroid : sound_clusters ) {
@@ -363,15 +473,138 @@ void sounds::process_sounds()
             overmap_buffer.signal_hordes( target, sig_power );
         }
         // Alert all monsters (that can hear) to the sound.
-        for( monster &critter : g->all_monsters() ) {
+        // Those further away than twice the volume certainly won't hear it, so don't look at them.
+        const int max_dist = vol * 2 - 1;
+        if( max_dist < 0 ) {
+            continue;
+        }
+        for( const shared_ptr_fast<monster> &critter : g->critter_tracker->find_in_radius( source,
+                max_dist, OVERMAP_LAYERS ) ) {
             // TODO: Generalize this to Creature::hear_sound
-            const int dist = sound_distance( source, critter.pos() );
+            const int dist = sound_distance( source, critter->pos() );
             if( vol * 2 > dist ) {
-                // Exclude monsters that certainly won't hear the sound
-                critter.hear_sound( source, vol, dist );
+                critter->hear_sound( source, vol, dist );
             }
         }
     }
+}
+
+// Apply the sounds to monsters by way of a grid holding the loudest sound reaching each cell
+static void process_sound_grid( bool around_walls )
+{
+    const map &here = get_map();
+    const int weather_vol = get_weather().weather_id->sound_attn;
+    sound_grid grid;
+    std::map<int, std::vector<int>> cell_costs;
+    // Hordes only get the strongest signal of every submap
+    std::map<tripoint_abs_sm, int> horde_signals;
+    // Every sound, for monsters that the sound kept for their cell doesn't reach
+    struct grid_sound {
+        tripoint source;
+        int volume = 0;
+        // Distances by cell on the sound's own Z level, if it was spread around walls
+        std::vector<int> dists_around_walls;
+    };
+    std::vector<grid_sound> grid_sounds;
+
+    for( const std::pair<tripoint, int> &sound : recent_sounds ) {
+        const tripoint &source = sound.first;
+        const int vol = sound.second - weather_vol;
+
+        const centroid as_centroid{
+            static_cast<float>( source.x ), static_cast<float>( source.y ), static_cast<float>( source.z ),
+            static_cast<float>( sound.second ), static_cast<float>( sound.second )
+        };
+        const int sig_power = get_signal_for_hordes( as_centroid );
+        if( sig_power > 0 ) {
+            // TODO: fix point types
+            const tripoint_abs_sm target( point_abs_sm( ms_to_sm_copy( here.getabs( source.xy() ) ) ),
+                                          source.z );
+            int &strongest = horde_signals[target];
+            strongest = std::max( strongest, sig_power );
+        }
+
+        if( vol <= 0 ) {
+            continue;
+        }
+        grid_sound &spread = grid_sounds.emplace_back( grid_sound{ source, vol, {} } );
+        const int max_dist = vol * 2 - 1;
+        const point min_cell( std::max( 0, ( source.x - max_dist ) / SOUND_CELL_SIZE ),
+                              std::max( 0, ( source.y - max_dist ) / SOUND_CELL_SIZE ) );
+        const point max_cell( std::min( SOUND_GRID_X - 1, ( source.x + max_dist ) / SOUND_CELL_SIZE ),
+                              std::min( SOUND_GRID_Y - 1, ( source.y + max_dist ) / SOUND_CELL_SIZE ) );
+        for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
+            if( sound_distance( source, tripoint( source.xy(), z ) ) > max_dist ) {
+                continue;
+            }
+            if( around_walls && z == source.z ) {
+                auto costs_iter = cell_costs.find( z );
+                if( costs_iter == cell_costs.end() ) {
+                    costs_iter = cell_costs.emplace( z, sound_cell_costs( z ) ).first;
+                }
+                spread.dists_around_walls = spread_sound_around_walls( grid, source, vol,
+                                            costs_iter->second );
+                continue;
+            }
+            for( int y = min_cell.y; y <= max_cell.y; y++ ) {
+                for( int x = min_cell.x; x <= max_cell.x; x++ ) {
+                    // Some of the cell may be closer than its center
+                    const int dist = sound_distance( source, sound_cell_center( point( x, y ), z ) );
+                    if( dist <= max_dist + SOUND_CELL_SIZE ) {
+                        grid.add( heard_sound{ source, vol, dist }, point( x, y ), z );
+                    }
+                }
+            }
+        }
+    }
+
+    for( const std::pair<const tripoint_abs_sm, int> &signal : horde_signals ) {
+        overmap_buffer.signal_hordes( signal.first, signal.second );
+    }
+
+    for( monster &critter : g->all_monsters() ) {
+        const std::optional<heard_sound> &heard = grid.at( critter.pos() );
+        if( !heard ) {
+            continue;
+        }
+        // Without walls in the way the exact distance is just as cheap
+        const int dist = around_walls && heard->source.z == critter.posz() ?
+                         heard->distance : sound_distance( heard->source, critter.pos() );
+        if( heard->volume * 2 > dist ) {
+            critter.hear_sound( heard->source, heard->volume, dist );
+            continue;
+        }
+        // The sound kept for the cell was picked by the distance to its center, so from
+        // this corner of the cell another sound may be the only one in range.
+        const point cell = sound_cell( critter.pos() );
+        const grid_sound *loudest = nullptr;
+        int loudest_dist = 0;
+        for( const grid_sound &sound : grid_sounds ) {
+            const int sound_dist = !sound.dists_around_walls.empty() && sound.source.z == critter.posz() ?
+                                   sound.dists_around_walls[cell.y * SOUND_GRID_X + cell.x] :
+                                   sound_distance( sound.source, critter.pos() );
+            if( sound.volume * 2 > sound_dist &&
+                ( loudest == nullptr || sound.volume - sound_dist > loudest->volume - loudest_dist ) ) {
+                loudest = &sound;
+                loudest_dist = sound_dist;
+            }
+        }
+        if( loudest != nullptr ) {
+            critter.hear_sound( loudest->source, loudest->volume, loudest_dist );
+        }
+    }
+}
+
+void sounds::process_sounds()
+{
+    ZoneScoped;
+
+    const std::string propagation = get_option<std::string>( "SOUND_PROPAGATION" );
+    if( propagation == "clusters" ) {
+        process_sound_clusters();
+    } else {
+        process_sound_grid( propagation == "grid_walls" );
+    }
     recent_sounds.clear();
 }
 
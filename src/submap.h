@@ -215,6 +215,8 @@ class submap : maptile_soa<SEEX, SEEY>
         void rotate( int turns );
 
         void store( JsonOut &jsout ) const;
+        /** Everything store() writes except the terrain, furniture, trap and radiation layers. */
+        void store_contents( JsonOut &jsout ) const;
         void load( JsonIn &jsin, const std::string &member_name, int version, const tripoint offset );
 
         // If is_uniform is true, this submap is a solid block of terrain
@@ -0,0 +1,415 @@
+#include "submap_binary.h"
+
+#include <array>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "binary_io.h"
+#include "coordinate_conversions.h"
+#include "game.h"
+#include "game_constants.h"
+#include "json.h"
+#include "mapdata.h"
+#include "string_formatter.h"
+#include "submap.h"
+#include "trap.h"
+
+namespace
+{
+
+constexpr std::array<char, 4> quad_magic = { { 'C', 'B', 'N', 'Q' } };
+// Bump when the layout below changes, keeping a reader for the old one.
+constexpr std::uint32_t quad_format_version = 1;
+constexpr int tiles_per_submap = SEEX * SEEY;
+
+using namespace binary_io;
+
+/** One id per tile, as indices into the table of the ids present in the submap. */
+struct id_layer {
+    std::vector<std::string> ids;
+    std::array<std::uint16_t, tiles_per_submap> cells = {};
+
+    explicit id_layer( const std::string &fill ) : ids{ fill } {}
+
+    void set( const int cell, const std::string &id ) {
+        for( size_t i = 0; i < ids.size(); i++ ) {
+            if( ids[i] == id ) {
+                cells[cell] = i;
+                return;
+            }
+        }
+        cells[cell] = ids.size();
+        ids.push_back( id );
+    }
+    const std::string &get( const int cell ) const {
+        return ids[cells[cell]];
+    }
+
+    void write( std::ostream &fout ) const {
+        write_u16( fout, ids.size() );
+        for( const std::string &id : ids ) {
+            write_string( fout, id );
+        }
+        for( const std::uint16_t cell : cells ) {
+            write_u16( fout, cell );
+        }
+    }
+    void read( std::istream &fin ) {
+        ids.resize( read_u16( fin ) );
+        for( std::string &id : ids ) {
+            id = read_string( fin );
+        }
+        for( std::uint16_t &cell : cells ) {
+            cell = read_u16( fin );
+            if( cell >= ids.size() ) {
+                throw std::runtime_error( "binary map quad refers to an unknown id" );
+            }
+        }
+    }
+};
+
+/** A submap as stored in the binary format, with ids kept as strings. */
+struct quad_entry {
+    int version = 0;
+    tripoint pos;
+    id_layer terrain{ ter_str_id::NULL_ID().str() };
+    id_layer furniture{ furn_str_id::NULL_ID().str() };
+    id_layer traps{ trap_str_id::NULL_ID().str() };
+    std::array<int, tiles_per_submap> radiation = {};
+    // JSON object holding the members written by submap::store_contents
+    std::string contents;
+
+    void write( std::ostream &fout ) const {
+        write_i32( fout, version );
+        write_i32( fout, pos.x );
+        write_i32( fout, pos.y );
+        write_i32( fout, pos.z );
+        terrain.write( fout );
+        furniture.write( fout );
+        traps.write( fout );
+        for( const int rad : radiation ) {
+            write_i32( fout, rad );
+        }
+        write_string( fout, contents );
+    }
+    void read( std::istream &fin ) {
+        version = read_i32( fin );
+        pos.x = read_i32( fin );
+        pos.y = read_i32( fin );
+        pos.z = read_i32( fin );
+        terrain.read( fin );
+        furniture.read( fin );
+        traps.read( fin );
+        for( int &rad : radiation ) {
+            rad = read_i32( fin );
+        }
+        contents = read_string( fin );
+    }
+};
+
+int cell_of( const point &p )
+{
+    return p.y * SEEX + p.x;
+}
+
+point point_of( const int cell )
+{
+    return point( cell % SEEX, cell / SEEX );
+}
+
+void write_header( std::ostream &fout, const size_t num_submaps )
+{
+    fout.write( quad_magic.data(), quad_magic.size() );
+    write_u32( fout, quad_format_version );
+    write_u32( fout, num_submaps );
+}
+
+size_t read_header( std::istream &fin )
+{
+    std::array<char, 4> magic;
+    read_bytes( fin, magic.data(), magic.size() );
+    if( magic != quad_magic ) {
+        throw std::runtime_error( "not a binary map quad" );
+    }
+    const std::uint32_t version = read_u32( fin );
+    if( version != quad_format_version ) {
+        throw std::runtime_error( string_format( "unsupported binary map quad version %d", version ) );
+    }
+    return read_u32( fin );
+}
+
+/** Raw text of the value the JsonIn is positioned at, which is then skipped. */
+std::string raw_json_value( JsonIn &jsin, const std::string &text )
+{
+    const int start = jsin.tell();
+    jsin.skip_value();
+    const int end = jsin.tell();
+    std::string value = text.substr( start, end - start );
+    // skip_value also eats the whitespace and separator that follow
+    const size_t first = value.find_first_not_of( " \t\r\n" );
+    size_t last = value.find_last_not_of( " \t\r\n," );
+    if( first == std::string::npos || last == std::string::npos ) {
+        jsin.error( "expected a value" );
+    }
+    return value.substr( first, last - first + 1 );
+}
+
+quad_entry entry_from_json( JsonIn &jsin, const std::string &text )
+{
+    quad_entry entry;
+    std::ostringstream contents;
+    JsonOut jsout( contents );
+    jsout.start_object();
+
+    jsin.start_object();
+    while( !jsin.end_object() ) {
+        const std::string name = jsin.get_member_name();
+        if( name == "version" ) {
+            entry.version = jsin.get_int();
+        } else if( name == "coordinates" ) {
+            jsin.start_array();
+            entry.pos.x = jsin.get_int();
+            entry.pos.y = jsin.get_int();
+            entry.pos.z = jsin.get_int();
+            jsin.end_array();
+        } else if( name == "terrain" ) {
+            int cell = 0;
+            jsin.start_array();
+            while( !jsin.end_array() ) {
+                std::string id;
+                int count = 1;
+                if( jsin.test_array() ) {
+                    jsin.start_array();
+                    id = jsin.get_string();
+                    count = jsin.get_int();
+                    jsin.end_array();
+                } else {
+                    id = jsin.get_string();
+                }
+                for( ; count > 0 && cell < tiles_per_submap; count--, cell++ ) {
+                    entry.terrain.set( cell, id );
+                }
+            }
+        } else if( name == "radiation" ) {
+            int cell = 0;
+            jsin.start_array();
+            while( !jsin.end_array() ) {
+                const int strength = jsin.get_int();
+                const int count = jsin.get_int();
+                for( int i = 0; i < count && cell < tiles_per_submap; i++, cell++ ) {
+                    entry.radiation[cell] = strength;
+                }
+            }
+        } else if( name == "furniture" || name == "traps" ) {
+            id_layer &layer = name == "furniture" ? entry.furniture : entry.traps;
+            jsin.start_array();
+            while( !jsin.end_array() ) {
+                jsin.start_array();
+                const int x = jsin.get_int();
+                const int y = jsin.get_int();
+                layer.set( cell_of( point( x, y ) ), jsin.get_string() );
+                jsin.end_array();
+            }
+        } else {
+            jsout.member( name );
+            *jsout.get_stream() << raw_json_value( jsin, text );
+            jsout.set_need_separator();
+        }
+    }
+
+    jsout.end_object();
+    entry.contents = contents.str();
+    return entry;
+}
+
+void entry_to_json( JsonOut &jsout, const quad_entry &entry )
+{
+    jsout.start_object();
+    jsout.member( "version", entry.version );
+    jsout.member( "coordinates" );
+    jsout.start_array();
+    jsout.write( entry.pos.x );
+    jsout.write( entry.pos.y );
+    jsout.write( entry.pos.z );
+    jsout.end_array();
+
+    // Same run length encoding as submap::store
+    jsout.member( "terrain" );
+    jsout.start_array();
+    for( int cell = 0; cell < tiles_per_submap; ) {
+        int run = 1;
+        while( cell + run < tiles_per_submap &&
+               entry.terrain.cells[cell + run] == entry.terrain.cells[cell] ) {
+            run++;
+        }
+        if( run == 1 ) {
+            jsout.write( entry.terrain.get( cell ) );
+        } else {
+            jsout.start_array();
+            jsout.write( entry.terrain.get( cell ) );
+            jsout.write( run );
+            jsout.end_array();
+        }
+        cell += run;
+    }
+    jsout.end_array();
+
+    jsout.member( "radiation" );
+    jsout.start_array();
+    for( int cell = 0; cell < tiles_per_submap; ) {
+        int run = 1;
+        while( cell + run < tiles_per_submap && entry.radiation[cell + run] == entry.radiation[cell] ) {
+            run++;
+        }
+        jsout.write( entry.radiation[cell] );
+        jsout.write( run );
+        cell += run;
+    }
+    jsout.end_array();
+
+    for( const auto &layer : {
+             std::make_pair( "furniture", &entry.furniture ), std::make_pair( "traps", &entry.traps )
+         } ) {
+        jsout.member( layer.first );
+        jsout.start_array();
+        for( int cell = 0; cell < tiles_per_submap; cell++ ) {
+            // Index 0 is the null id, which JSON leaves out
+            if( layer.second->cells[cell] != 0 ) {
+                jsout.start_array();
+                jsout.write( point_of( cell ).x );
+                jsout.write( point_of( cell ).y );
+                jsout.write( layer.second->get( cell ) );
+                jsout.end_array();
+            }
+        }
+        jsout.end_array();
+    }
+
+    std::istringstream contents_stream( entry.contents );
+    JsonIn contents( contents_stream );
+    contents.start_object();
+    while( !contents.end_object() ) {
+        jsout.member( contents.get_member_name() );
+        *jsout.get_stream() << raw_json_value( contents, entry.contents );
+        jsout.set_need_separator();
+    }
+    jsout.end_object();
+}
+
+} // namespace
+
+namespace submap_binary
+{
+
+bool is_binary_quad( std::istream &fin )
+{
+    const std::istream::pos_type start = fin.tellg();
+    std::array<char, 4> magic;
+    const bool matches = fin.read( magic.data(), magic.size() ) && magic == quad_magic;
+    fin.clear();
+    fin.seekg( start );
+    return matches;
+}
+
+void write_quad( std::ostream &fout,
+                 const std::vector<std::pair<tripoint, const submap *>> &submaps )
+{
+    write_header( fout, submaps.size() );
+    for( const auto &elem : submaps ) {
+        const submap &sm = *elem.second;
+        quad_entry entry;
+        entry.version = savegame_version;
+        entry.pos = elem.first;
+        for( int cell = 0; cell < tiles_per_submap; cell++ ) {
+            const point p = point_of( cell );
+            entry.terrain.set( cell, sm.get_ter( p ).id().str() );
+            entry.furniture.set( cell, sm.get_furn( p ).id().str() );
+            entry.traps.set( cell, sm.get_trap( p ).id().str() );
+            entry.radiation[cell] = sm.get_radiation( p );
+        }
+        std::ostringstream contents;
+        JsonOut jsout( contents );
+        jsout.start_object();
+        sm.store_contents( jsout );
+        jsout.end_object();
+        entry.contents = contents.str();
+        entry.write( fout );
+    }
+}
+
+void read_quad( std::istream &fin,
+                const std::function<void( const tripoint &, std::unique_ptr<submap> & )> &add )
+{
+    const size_t num_submaps = read_header( fin );
+    for( size_t i = 0; i < num_submaps; i++ ) {
+        quad_entry entry;
+        entry.read( fin );
+
+        auto sm = std::make_unique<submap>( sm_to_ms_copy( entry.pos ) );
+        // Resolve each distinct id once, rather than once per tile
+        std::vector<ter_id> ters;
+        for( const std::string &id : entry.terrain.ids ) {
+            ters.push_back( ter_str_id( id ).id() );
+        }
+        std::vector<furn_id> furns;
+        for( const std::string &id : entry.furniture.ids ) {
+            furns.push_back( furn_str_id( id ).id() );
+        }
+        std::vector<trap_id> traps;
+        for( const std::string &id : entry.traps.ids ) {
+            traps.push_back( trap_str_id( id ).id() );
+        }
+        for( int cell = 0; cell < tiles_per_submap; cell++ ) {
+            const point p = point_of( cell );
+            sm->set_ter( p, ters[entry.terrain.cells[cell]] );
+            sm->set_furn( p, furns[entry.furniture.cells[cell]] );
+            sm->set_trap( p, traps[entry.traps.cells[cell]] );
+            sm->set_radiation( p, entry.radiation[cell] );
+        }
+
+        std::istringstream contents_stream( entry.contents );
+        JsonIn jsin( contents_stream );
+        jsin.start_object();
+        while( !jsin.end_object() ) {
+            const std::string name = jsin.get_member_name();
+            sm->load( jsin, name, entry.version, multiply_xy( entry.pos, 12 ) );
+        }
+        add( entry.pos, sm );
+    }
+}
+
+void json_to_binary( std::istream &json, std::ostream &binary )
+{
+    const std::string text( std::istreambuf_iterator<char>( json ), {} );
+    std::istringstream text_stream( text );
+    JsonIn jsin( text_stream );
+    std::vector<quad_entry> entries;
+    jsin.start_array();
+    while( !jsin.end_array() ) {
+        entries.push_back( entry_from_json( jsin, text ) );
+    }
+
+    write_header( binary, entries.size() );
+    for( const quad_entry &entry : entries ) {
+        entry.write( binary );
+    }
+}
+
+void binary_to_json( std::istream &binary, std::ostream &json )
+{
+    const size_t num_submaps = read_header( binary );
+    JsonOut jsout( json );
+    jsout.start_array();
+    for( size_t i = 0; i < num_submaps; i++ ) {
+        quad_entry entry;
+        entry.read( binary );
+        entry_to_json( jsout, entry );
+    }
+    jsout.end_array();
+}
+
+} // namespace submap_binary
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <functional>
+#include <iosfwd>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "point.h"
+
+class submap;
+
+/**
+ * Compact binary encoding of a map quad, an alternative to the JSON array written by
+ * mapbuffer.  The terrain, furniture, trap and radiation layers are stored as packed
+ * arrays indexing into a table of the ids used in the submap, so loading them costs one
+ * id lookup per distinct id instead of one per tile.  Everything else (items, vehicles,
+ * fields...) is kept as the same JSON that submap::store_contents writes.
+ *
+ * Readers tell the formats apart by the leading magic, so a world may contain both.
+ */
+namespace submap_binary
+{
+
+/** Whether the stream holds a binary quad.  Does not consume anything. */
+bool is_binary_quad( std::istream &fin );
+
+void write_quad( std::ostream &fout,
+                 const std::vector<std::pair<tripoint, const submap *>> &submaps );
+
+/** Reads a binary quad, passing every submap with its coordinates to @p add. */
+void read_quad( std::istream &fin,
+                const std::function<void( const tripoint &, std::unique_ptr<submap> & )> &add );
+
+/**
+ * Lossless conversion between the JSON and binary quad formats.  Works on the ids as
+ * strings, so it doesn't need game data loaded.
+ */
+/**@{*/
+void json_to_binary( std::istream &json, std::ostream &binary );
+void binary_to_json( std::istream &binary, std::ostream &json );
+/**@}*/
+
+} // namespace submap_binary
@@ -1,8 +1,14 @@
 #include "world.h"
 
+#include <algorithm>
 #include <sstream>
 #include <cstring>
 #include <chrono>
+#include <deque>
+#include <future>
+#include <map>
+#include <stdexcept>
+#include <thread>
 
 #include "game.h"
 #include "avatar.h"
@@ -15,6 +21,7 @@
 #include "path_info.h"
 #include "compress.h"
 #include "sqlite3.h"
+#include "string_formatter.h"
 #include "zlib.h"
 
 #define dbg(x) DebugLogFL((x),DC::Main)
@@ -54,6 +61,136 @@ static sqlite3 *open_db( const std::string &path )
     return db;
 }
 
+/**
+ * Statements are prepared once per connection and reused; they have to be finalized
+ * through close_db before the connection goes away.
+ */
+static std::map<std::pair<sqlite3 *, const char *>, sqlite3_stmt *> cached_statements;
+
+static constexpr const char *count_file_sql = "SELECT count() FROM files WHERE path = :path";
+static constexpr const char *select_file_sql =
+    "SELECT data, compression FROM files WHERE path = :path LIMIT 1";
+static constexpr const char *upsert_file_sql = R"sql(
+        INSERT INTO files(path, parent, data, compression)
+        VALUES (:path, :parent, :data, 'zlib')
+        ON CONFLICT(path) DO UPDATE
+            SET data = excluded.data,
+                parent = excluded.parent,
+                compression = excluded.compression;
+    )sql";
+
+/** Borrows a cached statement, resetting it for the next user when going out of scope. */
+class cached_statement
+{
+    public:
+        cached_statement( sqlite3 *db, const char *sql ) {
+            auto it = cached_statements.find( { db, sql } );
+            if( it == cached_statements.end() ) {
+                if( sqlite3_prepare_v2( db, sql, -1, &stmt, nullptr ) != SQLITE_OK ) {
+                    dbg( DL::Error ) << "Failed to prepare statement: " << sqlite3_errmsg( db ) << '\n';
+                    sqlite3_finalize( stmt );
+                    throw std::runtime_error( "DB query failed" );
+                }
+                cached_statements.emplace( std::make_pair( db, sql ), stmt );
+            } else {
+                stmt = it->second;
+            }
+        }
+        cached_statement( const cached_statement & ) = delete;
+        cached_statement &operator=( const cached_statement & ) = delete;
+        ~cached_statement() {
+            sqlite3_reset( stmt );
+            sqlite3_clear_bindings( stmt );
+        }
+
+        sqlite3_stmt *get() const {
+            return stmt;
+        }
+
+    private:
+        sqlite3_stmt *stmt = nullptr;
+};
+
+/**
+ * While a save transaction is open, blobs are compressed on worker threads and written
+ * by the main thread in submission order.  Reads flush the queue first, so they always
+ * see the latest data.
+ */
+struct pending_write {
+    sqlite3 *db;
+    std::string path;
+    std::future<std::vector<std::byte>> data;
+};
+
+static std::deque<pending_write> pending_writes;
+static bool defer_db_writes = false;
+
+struct save_metrics {
+    int files = 0;
+    size_t raw_bytes = 0;
+    size_t compressed_bytes = 0;
+    std::chrono::microseconds compression_wait{ 0 };
+};
+
+static save_metrics current_save_metrics;
+
+static void insert_into_db( sqlite3 *db, const std::string &path,
+                            const std::vector<std::byte> &compressedData )
+{
+    size_t basePos = path.find_last_of( "/\\" );
+    auto parent = ( basePos == std::string::npos ) ? "" : path.substr( 0, basePos );
+
+    cached_statement stmt( db, upsert_file_sql );
+
+    if( sqlite3_bind_text( stmt.get(), sqlite3_bind_parameter_index( stmt.get(), ":path" ),
+                           path.c_str(), -1, SQLITE_TRANSIENT ) != SQLITE_OK ||
+        sqlite3_bind_text( stmt.get(), sqlite3_bind_parameter_index( stmt.get(), ":parent" ),
+                           parent.c_str(), -1, SQLITE_TRANSIENT ) != SQLITE_OK ||
+        sqlite3_bind_blob( stmt.get(), sqlite3_bind_parameter_index( stmt.get(), ":data" ),
+                           compressedData.data(), compressedData.size(), SQLITE_TRANSIENT ) != SQLITE_OK ) {
+        dbg( DL::Error ) << "Failed to bind parameters: " << sqlite3_errmsg( db ) << '\n';
+        throw std::runtime_error( "DB query failed" );
+    }
+
+    if( sqlite3_step( stmt.get() ) != SQLITE_DONE ) {
+        dbg( DL::Error ) << "Failed to execute query: " << sqlite3_errmsg( db ) << '\n';
+    }
+    current_save_metrics.compressed_bytes += compressedData.size();
+}
+
+static void write_oldest_pending()
+{
+    pending_write &pw = pending_writes.front();
+    const auto wait_start = std::chrono::steady_clock::now();
+    const std::vector<std::byte> compressedData = pw.data.get();
+    current_save_metrics.compression_wait +=
+        std::chrono::duration_cast<std::chrono::microseconds>( std::chrono::steady_clock::now() -
+                wait_start );
+    insert_into_db( pw.db, pw.path, compressedData );
+    pending_writes.pop_front();
+}
+
+static void flush_pending_writes()
+{
+    while( !pending_writes.empty() ) {
+        write_oldest_pending();
+    }
+}
+
+static void close_db( sqlite3 *db )
+{
+    flush_pending_writes();
+    for( auto it = cached_statements.begin(); it != cached_statements.end(); ) {
+        if( it->first.first == db ) {
+            sqlite3_finalize( it->second );
+            it = cached_statements.erase( it );
+        } else {
+            ++it;
+        }
+    }
+    sqlite3_close( db );
+}
+
 save_t::save_t( const std::string &name ): name( name ) {}
 
 std::string save_t::decoded_name() const
@@ -268,33 +405,25 @@ void load_external_option( const JsonObject &jo )
 
 static bool file_exist_in_db( sqlite3 *db, const std::string &path )
 {
-    int fileCount = 0;
-    const char *sql = "SELECT count() FROM files WHERE path = :path";
-    sqlite3_stmt *stmt = nullptr;
+    flush_pending_writes();
 
-    if( sqlite3_prepare_v2( db, sql, -1, &stmt, nullptr ) != SQLITE_OK ) {
-        dbg( DL::Error ) << "Failed to prepare statement: " << sqlite3_errmsg( db ) << '\n';
-        throw std::runtime_error( "DB query failed" );
-    }
+    int fileCount = 0;
+    cached_statement stmt( db, count_file_sql );
 
-    if( sqlite3_bind_text( stmt, sqlite3_bind_parameter_index( stmt, ":path" ), path.c_str(), -1,
-                           SQLITE_TRANSIENT ) != SQLITE_OK ) {
+    if( sqlite3_bind_text( stmt.get(), sqlite3_bind_parameter_index( stmt.get(), ":path" ),
+                           path.c_str(), -1, SQLITE_TRANSIENT ) != SQLITE_OK ) {
         dbg( DL::Error ) << "Failed to bind parameter: " << sqlite3_errmsg( db ) << '\n';
-        sqlite3_finalize( stmt );
         throw std::runtime_error( "DB query failed" );
     }
 
-    if( sqlite3_step( stmt ) == SQLITE_ROW ) {
+    if( sqlite3_step( stmt.get() ) == SQLITE_ROW ) {
         // Retrieve the count result
-        fileCount = sqlite3_column_int( stmt, 0 );
+        fileCount = sqlite3_column_int( stmt.get(), 0 );
     } else {
         dbg( DL::Error ) << "Failed to execute query: " << sqlite3_errmsg( db ) << '\n';
-        sqlite3_finalize( stmt );
         throw std::runtime_error( "DB query failed" );
     }
 
-    sqlite3_finalize( stmt );
-
     return fileCount > 0;
 }
 
@@ -303,70 +432,46 @@ static void write_to_db( sqlite3 *db, const std::string &path, file_write_fn wri
     std::ostringstream oss;
     writer( oss );
     auto data = oss.str();
+    current_save_metrics.files++;
+    current_save_metrics.raw_bytes += data.size();
+
+    if( defer_db_writes ) {
+        // Keep a few blobs per core in flight, so memory use stays bounded.
+        const size_t max_pending = 4 * std::max( 1U, std::thread::hardware_concurrency() );
+        while( pending_writes.size() >= max_pending ) {
+            write_oldest_pending();
+        }
+        pending_writes.push_back( { db, path, std::async( std::launch::async, []( std::string data ) {
+            std::vector<std::byte> compressedData;
+            zlib_compress( data, compressedData );
+            return compressedData;
+        }, std::move( data ) ) } );
+        return;
+    }
 
     std::vector<std::byte> compressedData;
     zlib_compress( data, compressedData );
-
-    size_t basePos = path.find_last_of( "/\\" );
-    auto parent = ( basePos == std::string::npos ) ? "" : path.substr( 0, basePos );
-
-    auto sql = R"sql(
-        INSERT INTO files(path, parent, data, compression)
-        VALUES (:path, :parent, :data, 'zlib')
-        ON CONFLICT(path) DO UPDATE
-            SET data = excluded.data,
-                parent = excluded.parent,
-                compression = excluded.compression;
-    )sql";
-
-    sqlite3_stmt *stmt = nullptr;
-
-    if( sqlite3_prepare_v2( db, sql, -1, &stmt, nullptr ) != SQLITE_OK ) {
-        dbg( DL::Error ) << "Failed to prepare statement: " << sqlite3_errmsg( db ) << '\n';
-        throw std::runtime_error( "DB query failed" );
-    }
-
-    if( sqlite3_bind_text( stmt, sqlite3_bind_parameter_index( stmt, ":path" ), path.c_str(), -1,
-                           SQLITE_TRANSIENT ) != SQLITE_OK ||
-        sqlite3_bind_text( stmt, sqlite3_bind_parameter_index( stmt, ":parent" ), parent.c_str(), -1,
-                           SQLITE_TRANSIENT ) != SQLITE_OK ||
-        sqlite3_bind_blob( stmt, sqlite3_bind_parameter_index( stmt, ":data" ), compressedData.data(),
-                           compressedData.size(), SQLITE_TRANSIENT ) != SQLITE_OK ) {
-        dbg( DL::Error ) << "Failed to bind parameters: " << sqlite3_errmsg( db ) << '\n';
-        sqlite3_finalize( stmt );
-        throw std::runtime_error( "DB query failed" );
-    }
-
-    if( sqlite3_step( stmt ) != SQLITE_DONE ) {
-        dbg( DL::Error ) << "Failed to execute query: " << sqlite3_errmsg( db ) << '\n';
-    }
-    sqlite3_finalize( stmt );
+    insert_into_db( db, path, compressedData );
 }
 
 static bool read_from_db( sqlite3 *db, const std::string &path, file_read_fn reader,
                           bool optional )
 {
-    const char *sql = "SELECT data, compression FROM files WHERE path = :path LIMIT 1";
+    flush_pending_writes();
 
-    sqlite3_stmt *stmt = nullptr;
+    cached_statement stmt( db, select_file_sql );
 
-    if( sqlite3_prepare_v2( db, sql, -1, &stmt, nullptr ) != SQLITE_OK ) {
-        dbg( DL::Error ) << "Failed to prepare statement: " << sqlite3_errmsg( db ) << '\n';
-        throw std::runtime_error( "DB query failed" );
-    }
-
-    if( sqlite3_bind_text( stmt, sqlite3_bind_parameter_index( stmt, ":path" ), path.c_str(), -1,
-                           SQLITE_TRANSIENT ) != SQLITE_OK ) {
+    if( sqlite3_bind_text( stmt.get(), sqlite3_bind_parameter_index( stmt.get(), ":path" ),
+                           path.c_str(), -1, SQLITE_TRANSIENT ) != SQLITE_OK ) {
         dbg( DL::Error ) << "Failed to bind parameter: " << sqlite3_errmsg( db ) << '\n';
-        sqlite3_finalize( stmt );
         throw std::runtime_error( "DB query failed" );
     }
 
-    if( sqlite3_step( stmt ) == SQLITE_ROW ) {
+    if( sqlite3_step( stmt.get() ) == SQLITE_ROW ) {
         // Retrieve the count result
-        const void *blobData = sqlite3_column_blob( stmt, 0 );
-        int blobSize = sqlite3_column_bytes( stmt, 0 );
-        auto compression_raw = sqlite3_column_text( stmt, 1 );
+        const void *blobData = sqlite3_column_blob( stmt.get(), 0 );
+        int blobSize = sqlite3_column_bytes( stmt.get(), 0 );
+        auto compression_raw = sqlite3_column_text( stmt.get(), 1 );
         std::string compression = compression_raw ? reinterpret_cast<const char *>( compression_raw ) : "";
 
         if( blobData == nullptr ) {
@@ -384,13 +489,9 @@ static bool read_from_db( sqlite3 *db, const std::string &path, file_read_fn rea
 
         std::istringstream stream( dataString );
         reader( stream );
-        sqlite3_finalize( stmt );
     } else {
-        auto err = sqlite3_errmsg( db );
-        sqlite3_finalize( stmt );
-
         if( !optional ) {
-            dbg( DL::Error ) << "Failed to execute query: " << err << '\n';
+            dbg( DL::Error ) << "Failed to execute query: " << sqlite3_errmsg( db ) << '\n';
             throw std::runtime_error( "DB query failed" );
         }
         return false;
@@ -427,16 +528,26 @@ world::world( WORLDINFO *info )
 
 world::~world()
 {
+    try {
+        wait_for_map_writes();
+    } catch( const std::exception &err ) {
+        debugmsg( "%s", err.what() );
+    }
+
     if( save_tx_start_ts != 0 ) {
         dbg( DL::Error ) << "Save transaction was not committed before world destruction";
     }
 
+    // Anything still queued belongs to an uncommitted transaction, which closing rolls back.
+    defer_db_writes = false;
+    pending_writes.clear();
+
     if( map_db ) {
-        sqlite3_close( map_db );
+        close_db( map_db );
     }
 
     if( save_db ) {
-        sqlite3_close( save_db );
+        close_db( save_db );
     }
 }
 
@@ -456,6 +567,9 @@ void world::start_save_tx()
     if( save_db ) {
         sqlite3_exec( save_db, "BEGIN TRANSACTION", NULL, NULL, NULL );
     }
+
+    current_save_metrics = save_metrics();
+    defer_db_writes = info->world_save_format == save_format::V2_COMPRESSED_SQLITE3;
 }
 
 int64_t world::commit_save_tx()
@@ -464,6 +578,9 @@ int64_t world::commit_save_tx()
         throw std::runtime_error( "Attempted to commit a save transaction while none was in progress" );
     }
 
+    flush_pending_writes();
+    defer_db_writes = false;
+
     if( map_db ) {
         sqlite3_exec( map_db, "COMMIT", NULL, NULL, NULL );
     }
@@ -477,6 +594,14 @@ int64_t world::commit_save_tx()
                   ).count();
     int64_t duration = now - save_tx_start_ts;
     save_tx_start_ts = 0;
+
+    if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
+        dbg( DL::Info ) << "Saved " << current_save_metrics.files << " files in " << duration << "ms: "
+                        << current_save_metrics.raw_bytes << " bytes compressed to "
+                        << current_save_metrics.compressed_bytes << ", "
+                        << current_save_metrics.compression_wait.count() / 1000
+                        << "ms spent waiting on compression";
+    }
     return duration;
 }
 
@@ -495,28 +620,86 @@ static std::string get_quad_filename( const tripoint &om_addr )
     return string_format( "%d.%d.%d.map", om_addr.x, om_addr.y, om_addr.z );
 }
 
-bool world::read_map_quad( const tripoint &om_addr, file_read_json_fn reader ) const
+std::string world::map_quad_path( const tripoint &om_addr ) const
 {
     const std::string dirname = get_quad_dirname( om_addr );
     std::string quad_path = dirname + "/" + get_quad_filename( om_addr );
+    if( info->world_save_format != save_format::V2_COMPRESSED_SQLITE3 && !file_exist( quad_path ) ) {
+        // Fix for old saves where the path was generated using std::stringstream, which
+        // did format the number using the current locale. That formatting may insert
+        // thousands separators, so the resulting path is "map/1,234.7.8.map" instead
+        // of "map/1234.7.8.map".
+        std::ostringstream buffer;
+        buffer << dirname << "/" << om_addr.x << "." << om_addr.y << "." << om_addr.z << ".map";
+        if( file_exist( buffer.str() ) ) {
+            quad_path = buffer.str();
+        }
+    }
+    return quad_path;
+}
+
+template<typename T>
+static bool is_ready( const std::future<T> &f )
+{
+    return f.wait_for( std::chrono::seconds( 0 ) ) == std::future_status::ready;
+}
+
+bool world::read_map_quad( const tripoint &om_addr,
+                           const std::function<void( std::istream &, const std::string & )> &reader ) const
+{
+    // Paths as they were shown in JSON errors before quads could come from memory
+    const auto error_path = [this]( const std::string & quad_path ) {
+        if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
+            return quad_path;
+        }
+        return info->folder_path() + "/" + quad_path;
+    };
+
+    std::shared_ptr<const std::string> pending;
+    {
+        std::lock_guard<std::mutex> lk( pending_map_mutex );
+        const auto it = pending_map_quads.find( om_addr );
+        if( it != pending_map_quads.end() ) {
+            pending = it->second;
+        }
+    }
+    if( pending ) {
+        // Still queued for the background writer, what's on disk is stale.
+        std::istringstream fin( *pending );
+        reader( fin, error_path( get_quad_dirname( om_addr ) + "/" + get_quad_filename( om_addr ) ) );
+        return true;
+    }
+
+    const auto prefetched = prefetched_map_quads.find( om_addr );
+    if( prefetched != prefetched_map_quads.end() && !is_ready( prefetched->second ) ) {
+        // Still reading, don't wait for it and read the file directly instead.
+        drop_prefetched_map_quad( om_addr );
+    } else if( prefetched != prefetched_map_quads.end() ) {
+        std::future<std::optional<std::string>> data = std::move( prefetched->second );
+        prefetched_map_quads.erase( prefetched );
+        std::optional<std::string> contents;
+        try {
+            contents = data.get();
+        } catch( const std::exception &err ) {
+            // Fall through to the regular read, which reports the error properly.
+            dbg( DL::Warn ) << "Prefetching map quad " << om_addr.to_string() << " failed: " << err.what();
+        }
+        if( contents ) {
+            std::istringstream fin( *contents );
+            reader( fin, error_path( get_quad_dirname( om_addr ) + "/" + get_quad_filename( om_addr ) ) );
+            return true;
+        }
+    }
 
+    const std::string quad_path = map_quad_path( om_addr );
+    const auto read_quad = [&]( std::istream & fin ) {
+        reader( fin, error_path( quad_path ) );
+    };
     // V2 logic
     if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
-        return read_from_db_json( map_db, quad_path, reader, true );
+        return read_from_db( map_db, quad_path, read_quad, true );
     } else {
-        if( !file_exist( quad_path ) ) {
-            // Fix for old saves where the path was generated using std::stringstream, which
-            // did format the number using the current locale. That formatting may insert
-            // thousands separators, so the resulting path is "map/1,234.7.8.map" instead
-            // of "map/1234.7.8.map".
-            std::ostringstream buffer;
-            buffer << dirname << "/" << om_addr.x << "." << om_addr.y << "." << om_addr.z << ".map";
-            if( file_exist( buffer.str() ) ) {
-                quad_path = buffer.str();
-            }
-        }
-
-        return read_from_file_json( quad_path, reader, true );
+        return read_from_file( quad_path, read_quad, true );
     }
 }
 
@@ -535,6 +718,153 @@ bool world::write_map_quad( const tripoint &om_addr, file_write_fn writer ) cons
     }
 }
 
+void world::write_map_quad_async( const tripoint &om_addr, std::string data )
+{
+    // Anything read ahead of this is outdated now.
+    drop_prefetched_map_quad( om_addr );
+
+    const auto write_data = [&data]( std::ostream & fout ) {
+        fout << data;
+    };
+    // The database connection belongs to the main thread.
+    if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
+        write_map_quad( om_addr, write_data );
+        return;
+    }
+
+    std::lock_guard<std::mutex> lk( pending_map_mutex );
+    pending_map_quads[om_addr] = std::make_shared<const std::string>( std::move( data ) );
+    if( !map_writer_running ) {
+        if( map_writer.valid() ) {
+            // The previous writer has already finished its loop, this only collects it.
+            map_writer.get();
+        }
+        if( !map_write_error.empty() ) {
+            // Whatever failed stays queued and is retried by the new writer.
+            debugmsg( "Failed to save map quads: %s", map_write_error );
+            map_write_error.clear();
+        }
+        map_writer_running = true;
+        map_writer = std::async( std::launch::async, &world::write_pending_map_quads, this );
+    }
+}
+
+void world::write_pending_map_quads()
+{
+    while( true ) {
+        tripoint om_addr;
+        std::shared_ptr<const std::string> data;
+        {
+            std::lock_guard<std::mutex> lk( pending_map_mutex );
+            if( pending_map_quads.empty() || !map_write_error.empty() ) {
+                map_writer_running = false;
+                return;
+            }
+            om_addr = pending_map_quads.begin()->first;
+            data = pending_map_quads.begin()->second;
+        }
+        try {
+            write_map_quad( om_addr, [&data]( std::ostream & fout ) {
+                fout << *data;
+            } );
+        } catch( const std::exception &err ) {
+            std::lock_guard<std::mutex> lk( pending_map_mutex );
+            map_write_error = err.what();
+            map_writer_running = false;
+            return;
+        }
+        std::lock_guard<std::mutex> lk( pending_map_mutex );
+        // A newer copy may have been queued while this one was written.
+        const auto it = pending_map_quads.find( om_addr );
+        if( it != pending_map_quads.end() && it->second == data ) {
+            pending_map_quads.erase( it );
+        }
+    }
+}
+
+void world::drop_prefetched_map_quad( const tripoint &om_addr ) const
+{
+    const auto it = prefetched_map_quads.find( om_addr );
+    if( it == prefetched_map_quads.end() ) {
+        return;
+    }
+    if( !is_ready( it->second ) ) {
+        stale_map_prefetches.push_back( std::move( it->second ) );
+    }
+    prefetched_map_quads.erase( it );
+}
+
+void world::prefetch_map_quad( const tripoint &om_addr )
+{
+    // Reading through the database connection is limited to the main thread.
+    if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
+        return;
+    }
+    if( prefetched_map_quads.contains( om_addr ) ) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lk( pending_map_mutex );
+        if( pending_map_quads.contains( om_addr ) ) {
+            // read_map_quad will use the queued data, and the file may be half written.
+            return;
+        }
+    }
+
+    // Quads read ahead for a path the player didn't take are only dropped once finished,
+    // so a stale read never blocks the main thread.
+    static constexpr size_t max_prefetched_quads = 64;
+    stale_map_prefetches.erase( std::remove_if( stale_map_prefetches.begin(),
+                                stale_map_prefetches.end(), is_ready<std::optional<std::string>> ),
+                                stale_map_prefetches.end() );
+    for( auto it = prefetched_map_quads.begin();
+         prefetched_map_quads.size() >= max_prefetched_quads && it != prefetched_map_quads.end(); ) {
+        if( is_ready( it->second ) ) {
+            it = prefetched_map_quads.erase( it );
+        } else {
+            ++it;
+        }
+    }
+    if( prefetched_map_quads.size() + stale_map_prefetches.size() >= max_prefetched_quads ) {
+        return;
+    }
+
+    const std::string path = info->folder_path() + "/" + map_quad_path( om_addr );
+    const auto read_quad = [path]() -> std::optional<std::string> {
+        if( !::file_exist( path ) ) {
+            return std::nullopt;
+        }
+        cata_ifstream fin = std::move( cata_ifstream().mode( cata_ios_mode::binary ).open( path ) );
+        if( !fin.is_open() ) {
+            throw std::runtime_error( "opening file failed" );
+        }
+        std::ostringstream contents;
+        contents << fin->rdbuf();
+        if( fin.bad() ) {
+            throw std::runtime_error( "reading file failed" );
+        }
+        return contents.str();
+    };
+    prefetched_map_quads.emplace( om_addr, std::async( std::launch::async, read_quad ) );
+}
+
+void world::wait_for_map_writes()
+{
+    if( !map_writer.valid() ) {
+        return;
+    }
+    map_writer.get();
+
+    std::lock_guard<std::mutex> lk( pending_map_mutex );
+    if( !map_write_error.empty() ) {
+        // The quads stay queued, the next write retries them.
+        const std::string error = string_format( "failed to save %d map quads: %s",
+                                  pending_map_quads.size(), map_write_error );
+        map_write_error.clear();
+        throw std::runtime_error( error );
+    }
+}
+
 /**
  * DOMAIN SPECIFIC: OVERMAP
  */
@@ -646,6 +976,10 @@ sqlite3 *world::get_player_db()
     if( !save_db ) {
         save_db = open_db( info->folder_path() + "/" + get_player_path() + ".sqlite3" );
         last_save_id = g->u.get_save_id();
+        // Opened in the middle of a save, join the transaction the map database is already in.
+        if( save_tx_start_ts != 0 ) {
+            sqlite3_exec( save_db, "BEGIN TRANSACTION", NULL, NULL, NULL );
+        }
     }
 
     if( last_save_id != g->u.get_save_id() ) {
@@ -780,7 +1114,7 @@ void world::convert_from_v1( const std::unique_ptr<WORLDINFO> &old_world )
             if( save_id != last_save_id ) {
                 if( last_save_db ) {
                     sqlite3_exec( last_save_db, "COMMIT", NULL, NULL, NULL );
-                    sqlite3_close( last_save_db );
+                    close_db( last_save_db );
                 }
                 last_save_db = open_db( info->folder_path() + "/" + save_id + ".sqlite3" );
                 last_save_id = save_id;
@@ -821,7 +1155,7 @@ void world::convert_from_v1( const std::unique_ptr<WORLDINFO> &old_world )
 
     if( last_save_db ) {
         sqlite3_exec( last_save_db, "COMMIT", NULL, NULL, NULL );
-        sqlite3_close( last_save_db );
+        close_db( last_save_db );
     }
 
     sqlite3_exec( map_db, "COMMIT", NULL, NULL, NULL );
@@ -1,7 +1,13 @@
 #pragma once
 
 #include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <vector>
 #include "json.h"
 #include "options.h"
 #include "type_id.h"
@@ -110,8 +116,29 @@ class world
          * lay out files differently, so centralize file placement logic here rather than
          * scattering it throughout the codebase.
          */
-        bool read_map_quad( const tripoint &om_addr, file_read_json_fn reader ) const;
+        /** Reads a map quad, the reader also gets the quad's path for error messages. */
+        bool read_map_quad( const tripoint &om_addr,
+                            const std::function<void( std::istream &, const std::string & )> &reader ) const;
         bool write_map_quad( const tripoint &om_addr, file_write_fn writer ) const;
+        /**
+         * Queue an already serialized map quad to be written by a background thread.
+         * Until it is on disk, read_map_quad serves the quad from the queued data.
+         * Save formats that can't be written off the main thread are written immediately.
+         */
+        void write_map_quad_async( const tripoint &om_addr, std::string data );
+        /**
+         * Block until every queued map quad has been written.
+         * @throws std::runtime_error if some couldn't be written.  They stay queued,
+         * and the next write_map_quad_async retries them.
+         */
+        void wait_for_map_writes();
+        /**
+         * Start reading a map quad on a background thread, so that a later read_map_quad
+         * of it doesn't have to wait for the disk.  Only the raw file is read ahead,
+         * deserializing it stays with the caller.  Does nothing for save formats that
+         * can't be read off the main thread.
+         */
+        void prefetch_map_quad( const tripoint &om_addr );
 
         bool overmap_exists( const point_abs_om &p ) const;
         bool read_overmap( const point_abs_om &p, file_read_fn reader ) const;
@@ -175,6 +202,28 @@ class world
 
         sqlite3 *map_db = nullptr;
 
+        /** Serialized map quads waiting for the background writer, guarded by pending_map_mutex. */
+        std::map<tripoint, std::shared_ptr<const std::string>> pending_map_quads;
+        mutable std::mutex pending_map_mutex;
+        bool map_writer_running = false;
+        std::string map_write_error;
+        std::future<void> map_writer;
+        void write_pending_map_quads();
+
+        /**
+         * Map quads being read ahead by prefetch_map_quad, an empty optional means there
+         * was no such file.  Only touched from the main thread.
+         */
+        mutable std::map<tripoint, std::future<std::optional<std::string>>> prefetched_map_quads;
+        /**
+         * Reads dropped from prefetched_map_quads while still running.  Destroying a
+         * std::async future waits for it, so they are kept here until they finish.
+         */
+        mutable std::vector<std::future<std::optional<std::string>>> stale_map_prefetches;
+        /** Forgets the read ahead of om_addr, if any, without waiting for it. */
+        void drop_prefetched_map_quad( const tripoint &om_addr ) const;
+        std::string map_quad_path( const tripoint &om_addr ) const;
+
         sqlite3 *save_db = nullptr;
         std::string last_save_id = "";
         sqlite3 *get_player_db();
@@ -0,0 +1,134 @@
+#include "catch/catch.hpp"
+
+#include <cstdlib>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "character.h"
+#include "creature_tracker.h"
+#include "game.h"
+#include "line.h"
+#include "map_helpers.h"
+#include "monster.h"
+#include "point.h"
+#include "state_helpers.h"
+#include "type_id.h"
+
+static constexpr int NUM_TEST_MONSTERS = 1000;
+
+// Solid rock underground doesn't matter to the tracker
+static monster &force_spawn_monster( const tripoint &p )
+{
+    monster *const added = g->place_critter_around( make_shared_fast<monster>( mtype_id( "mon_zombie" ) ),
+                           p, 0, true );
+    REQUIRE( added );
+    return *added;
+}
+
+// Monsters spread over the whole map, on two Z levels
+static void spawn_many_monsters()
+{
+    clear_all_state();
+    int spawned = 0;
+    for( int z = 0; z >= -1; z-- ) {
+        for( int y = 1; y < MAPSIZE_Y - 1 && spawned < NUM_TEST_MONSTERS; y += 5 ) {
+            for( int x = 1 + y % 3; x < MAPSIZE_X - 1 && spawned < NUM_TEST_MONSTERS; x += 7 ) {
+                if( tripoint( x, y, z ) != get_player_character().pos() ) {
+                    force_spawn_monster( tripoint( x, y, z ) );
+                    spawned++;
+                }
+            }
+        }
+    }
+    REQUIRE( g->num_creatures() == NUM_TEST_MONSTERS + 1 );
+}
+
+static std::set<const monster *> scan_all_monsters( const tripoint &center, int radius,
+        int z_radius )
+{
+    std::set<const monster *> result;
+    for( const monster &critter : g->all_monsters() ) {
+        if( rl_dist( center.xy(), critter.pos().xy() ) <= radius &&
+            std::abs( center.z - critter.pos().z ) <= z_radius ) {
+            result.insert( &critter );
+        }
+    }
+    return result;
+}
+
+static void check_radius_queries()
+{
+    const std::vector<tripoint> centers = {
+        tripoint( 0, 0, 0 ), tripoint( 66, 66, 0 ), tripoint( 30, 100, -1 ), tripoint( 131, 5, 0 ),
+        tripoint( -20, 60, 0 )
+    };
+    for( const tripoint &center : centers ) {
+        for( int radius : { 0, 3, 12, 40, 200 } ) {
+            for( int z_radius : { 0, 1 } ) {
+                CAPTURE( center, radius, z_radius );
+                std::set<const monster *> found;
+                for( const shared_ptr_fast<monster> &critter : g->critter_tracker->find_in_radius( center,
+                        radius, z_radius ) ) {
+                    CHECK( found.insert( critter.get() ).second );
+                }
+                CHECK( found == scan_all_monsters( center, radius, z_radius ) );
+            }
+        }
+    }
+}
+
+TEST_CASE( "creature_tracker_radius_queries_match_a_full_scan", "[creature]" )
+{
+    spawn_many_monsters();
+    check_radius_queries();
+
+    SECTION( "after monsters move, swap and die" ) {
+        std::vector<monster *> monsters;
+        for( monster &critter : g->all_monsters() ) {
+            monsters.push_back( &critter );
+        }
+        // Across submap borders and Z levels
+        monsters[0]->setpos( tripoint( 70, 70, -1 ) );
+        monsters[1]->setpos( tripoint( 0, 130, 0 ) );
+        g->swap_critters( *monsters[2], *monsters[NUM_TEST_MONSTERS - 1] );
+        monsters[3]->die( nullptr );
+        g->remove_zombie( *monsters[4] );
+        check_radius_queries();
+
+        g->critter_tracker->rebuild_cache();
+        check_radius_queries();
+    }
+}
+
+TEST_CASE( "creature_tracker_range_queries_include_bounds", "[creature]" )
+{
+    clear_all_state();
+    monster &inside = force_spawn_monster( tripoint( 23, 24, 0 ) );
+    force_spawn_monster( tripoint( 23, 25, 0 ) );
+    force_spawn_monster( tripoint( 23, 24, 1 ) );
+
+    const std::vector<shared_ptr_fast<monster>> found = g->critter_tracker->find_in_range(
+                tripoint( 12, 12, 0 ), tripoint( 23, 24, 0 ) );
+    REQUIRE( found.size() == 1 );
+    CHECK( found.front().get() == &inside );
+}
+
+TEST_CASE( "creature_tracker_query_benchmark", "[.][creature][benchmark]" )
+{
+    spawn_many_monsters();
+    const tripoint center( 66, 66, 0 );
+
+    BENCHMARK( "scan 1000 monsters within 10 tiles" ) {
+        return scan_all_monsters( center, 10, 0 ).size();
+    };
+    BENCHMARK( "query 1000 monsters within 10 tiles" ) {
+        return g->critter_tracker->find_in_radius( center, 10 ).size();
+    };
+    BENCHMARK( "scan 1000 monsters within 40 tiles" ) {
+        return scan_all_monsters( center, 40, 0 ).size();
+    };
+    BENCHMARK( "query 1000 monsters within 40 tiles" ) {
+        return g->critter_tracker->find_in_radius( center, 40 ).size();
+    };
+}
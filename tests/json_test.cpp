@@ -2,11 +2,14 @@
 
 #include <list>
 #include <sstream>
+#include <string_view>
 
 #include "bodypart.h"
 #include "json.h"
 #include "cached_options.h"
 #include "cata_utility.h"
+#include "filesystem.h"
+#include "path_info.h"
 #include "string_formatter.h"
 #include "type_id.h"
 
@@ -252,8 +255,11 @@ static void test_get_string( const std::string &str, const std::string &json )
     std::istringstream iss( json );
     JsonIn jsin( iss );
     CHECK( jsin.get_string() == str );
+    JsonIn jsin_buffer( std::string_view{ json } );
+    CHECK( jsin_buffer.get_string() == str );
 }
 
+// Both input backends must report errors at the same location.
 template<typename Matcher>
 static void test_get_string_throws_matches( Matcher &&matcher, const std::string &json )
 {
@@ -261,6 +267,8 @@ static void test_get_string_throws_matches( Matcher &&matcher, const std::string
     std::istringstream iss( json );
     JsonIn jsin( iss );
     CHECK_THROWS_MATCHES( jsin.get_string(), JsonError, matcher );
+    JsonIn jsin_buffer( std::string_view{ json } );
+    CHECK_THROWS_MATCHES( jsin_buffer.get_string(), JsonError, matcher );
 }
 
 template<typename Matcher>
@@ -272,6 +280,8 @@ static void test_string_error_throws_matches( Matcher &&matcher, const std::stri
     std::istringstream iss( json );
     JsonIn jsin( iss );
     CHECK_THROWS_MATCHES( jsin.string_error( "<message>", offset ), JsonError, matcher );
+    JsonIn jsin_buffer( std::string_view{ json } );
+    CHECK_THROWS_MATCHES( jsin_buffer.string_error( "<message>", offset ), JsonError, matcher );
 }
 
 TEST_CASE( "jsonin_get_string", "[json]" )
@@ -481,3 +491,56 @@ TEST_CASE( "serialize_optional", "[json]" )
         test_serialization( v, "[1,2,3]" );
     }
 }
+
+TEST_CASE( "jsonobject_from_precomputed_index", "[json]" )
+{
+    const std::string json = R"([ { "a": 1, "b": [ 2, 3 ] }, { "c": "d" } ])";
+    std::vector<json_object_index> indices;
+    {
+        // Indexed through a different JsonIn, as a data loading worker would.
+        JsonIn jsin( std::string_view{ json } );
+        jsin.start_array();
+        while( !jsin.end_array() ) {
+            indices.push_back( JsonObject::index( jsin ) );
+        }
+    }
+    REQUIRE( indices.size() == 2 );
+
+    JsonIn jsin( std::string_view{ json } );
+    JsonObject first( jsin, std::move( indices[0] ) );
+    CHECK( first.get_int( "a" ) == 1 );
+    CHECK( first.get_array( "b" ).size() == 2 );
+    first.finish();
+    JsonObject second( jsin, std::move( indices[1] ) );
+    CHECK( second.get_string( "c" ) == "d" );
+    second.finish();
+    // Left where scanning the objects in place would have.
+    CHECK( jsin.end_array() );
+}
+
+TEST_CASE( "json_input_backends_benchmark", "[.][json][benchmark]" )
+{
+    // Roughly what loading the game data costs, without the actual loading.
+    std::vector<std::string> contents;
+    for( const std::string &file : get_files_from_path( ".json", PATH_INFO::datadir() + "json",
+            true, true ) ) {
+        contents.push_back( read_entire_file( file ) );
+    }
+    REQUIRE( !contents.empty() );
+
+    BENCHMARK( "istringstream" ) {
+        for( const std::string &data : contents ) {
+            std::istringstream iss( data );
+            JsonIn jsin( iss );
+            jsin.skip_value();
+        }
+        return contents.size();
+    };
+    BENCHMARK( "buffer" ) {
+        for( const std::string &data : contents ) {
+            JsonIn jsin( std::string_view{ data } );
+            jsin.skip_value();
+        }
+        return contents.size();
+    };
+}
@@ -10,6 +10,7 @@
 #include "lru_cache.h"
 #include "map.h"
 #include "map_memory.h"
+#include "memory_fast.h"
 #include "point.h"
 #include "string_formatter.h"
 
@@ -75,7 +76,72 @@ TEST_CASE( "map_memory_forgets", "[map_memory]" )
     memory.memorize_symbol( p3, 1 );
 }
 
-// TODO: map memory save / load
+static std::string serialize_region( const mm_region &reg )
+{
+    std::ostringstream out;
+    JsonOut jsout( out );
+    reg.serialize( jsout );
+    return out.str();
+}
+
+static void deserialize_region( mm_region &reg, const std::string &data )
+{
+    std::istringstream in( data );
+    JsonIn jsin( in );
+    reg.deserialize( jsin );
+}
+
+TEST_CASE( "map_memory_region_round_trip", "[map_memory]" )
+{
+    mm_region reg;
+    for( auto &column : reg.submaps ) {
+        for( shared_ptr_fast<mm_submap> &sm : column ) {
+            sm = make_shared_fast<mm_submap>();
+        }
+    }
+    const memorized_terrain_tile dirt{ memorized_tile_id( "t_dirt" ), 1, 2 };
+    const memorized_terrain_tile chair{ memorized_tile_id( "f_chair" ), 0, 3 };
+    reg.submaps[0][0]->set_tile( point( 3, 4 ), dirt );
+    reg.submaps[0][0]->set_tile( point( 5, 4 ), chair );
+    reg.submaps[2][5]->set_tile( point_zero, dirt );
+    reg.submaps[7][7]->set_symbol( point( 1, 1 ), 'x' );
+
+    const std::string data = serialize_region( reg );
+    mm_region loaded;
+    deserialize_region( loaded, data );
+    for( size_t x = 0; x < MM_REG_SIZE; x++ ) {
+        for( size_t y = 0; y < MM_REG_SIZE; y++ ) {
+            for( int sx = 0; sx < SEEX; sx++ ) {
+                for( int sy = 0; sy < SEEY; sy++ ) {
+                    const point p( sx, sy );
+                    CHECK( loaded.submaps[x][y]->tile( p ) == reg.submaps[x][y]->tile( p ) );
+                    CHECK( loaded.submaps[x][y]->symbol( p ) == reg.submaps[x][y]->symbol( p ) );
+                }
+            }
+        }
+    }
+    CHECK( loaded.submaps[0][0]->tile( point( 5, 4 ) ).tile.str() == "f_chair" );
+    // Saving what was loaded gives the same file.
+    CHECK( serialize_region( loaded ) == data );
+}
+
+TEST_CASE( "map_memory_loads_regions_without_string_table", "[map_memory]" )
+{
+    // Regions saved before tile ids were interned have the id strings inline.
+    std::ostringstream legacy;
+    legacy << "[[[\"t_grass\",0,1,0," << SEEX * SEEY << "]]";
+    for( int i = 1; i < MM_REG_SIZE * MM_REG_SIZE; i++ ) {
+        legacy << ",null";
+    }
+    legacy << "]";
+
+    mm_region loaded;
+    deserialize_region( loaded, legacy.str() );
+    const memorized_terrain_tile grass{ memorized_tile_id( "t_grass" ), 0, 1 };
+    CHECK( loaded.submaps[0][0]->tile( point_zero ) == grass );
+    CHECK( loaded.submaps[0][0]->tile( point( SEEX - 1, SEEY - 1 ) ) == grass );
+    CHECK( loaded.submaps[1][0]->is_empty() );
+}
 
 #include <chrono>
 
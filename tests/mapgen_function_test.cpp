@@ -1,6 +1,23 @@
 #include "catch/catch.hpp"
 
+#include <utility>
+#include <vector>
+
+#include "calendar.h"
+#include "coordinates.h"
+#include "game_constants.h"
+#include "item.h"
+#include "map.h"
+#include "mapbuffer.h"
 #include "mapgen.h"
+#include "mapgen_functions.h"
+#include "mapgendata.h"
+#include "omdata.h"
+#include "options_helpers.h"
+#include "overmapbuffer.h"
+#include "point.h"
+#include "rng.h"
+#include "state_helpers.h"
 #include "type_id.h"
 
 TEST_CASE( "connects_to", "[mapgen][connects]" )
@@ -88,3 +105,105 @@ TEST_CASE( "connects_to", "[mapgen][connects]" )
         CHECK( connects_to( oter_id( "sewer_nesw" ), west ) );
     }
 }
+
+TEST_CASE( "generating_an_omt_again_gives_the_same_map", "[mapgen]" )
+{
+    clear_all_state();
+    const tripoint_abs_omt pos( 10, 10, 0 );
+    overmap_buffer.ter_set( pos, oter_id( "house_01_north" ) );
+    const tripoint_abs_sm sm_pos = project_to<coords::sm>( pos );
+
+    const auto generate = [&]() {
+        MAPBUFFER.clear();
+        tinymap tm;
+        tm.generate( sm_pos.raw(), calendar::turn );
+        std::vector<std::pair<ter_id, furn_id>> squares;
+        for( int x = 0; x < SEEX * 2; x++ ) {
+            for( int y = 0; y < SEEY * 2; y++ ) {
+                squares.emplace_back( tm.ter( point( x, y ) ), tm.furn( point( x, y ) ) );
+            }
+        }
+        return squares;
+    };
+
+    const std::vector<std::pair<ter_id, furn_id>> first = generate();
+    // Whatever was rolled in between must not matter
+    rng( 0, 1000 );
+    CHECK( generate() == first );
+    MAPBUFFER.clear();
+}
+
+TEST_CASE( "json_mapgen_plan_matches_applying_pieces", "[mapgen]" )
+{
+    clear_all_state();
+    const tripoint_abs_omt pos( 10, 10, 0 );
+    const tripoint_abs_sm sm_pos = project_to<coords::sm>( pos );
+
+    struct generated_map {
+        std::vector<std::pair<ter_id, furn_id>> squares;
+        std::vector<std::vector<itype_id>> items;
+        cata_default_random_engine rng_state;
+    };
+    const auto generate = [&]( const oter_id & terrain ) {
+        // Start from the same field every time, then run the mapgen over it from a fixed seed.
+        MAPBUFFER.clear();
+        overmap_buffer.ter_set( pos, oter_id( "field" ) );
+        tinymap tm;
+        tm.generate( sm_pos.raw(), calendar::turn );
+        overmap_buffer.ter_set( pos, terrain );
+        generated_map result;
+        {
+            const rng_seed_scope seeded( 1234 );
+            mapgendata dat( pos, tm, 0.0f, calendar::turn, nullptr );
+            REQUIRE( run_mapgen_func( terrain->get_mapgen_id(), dat ) );
+            result.rng_state = rng_get_engine();
+        }
+        for( int x = 0; x < SEEX * 2; x++ ) {
+            for( int y = 0; y < SEEY * 2; y++ ) {
+                result.squares.emplace_back( tm.ter( point( x, y ) ), tm.furn( point( x, y ) ) );
+                std::vector<itype_id> &here = result.items.emplace_back();
+                for( const auto &it : tm.i_at( point( x, y ) ) ) {
+                    here.push_back( it->typeId() );
+                }
+            }
+        }
+        return result;
+    };
+
+    for( const char *id : {
+             "house_01_north", "s_gas_north", "s_library_north", "police_north", "fire_station_north"
+         } ) {
+        INFO( id );
+        const oter_id terrain( id );
+        generated_map planned;
+        {
+            override_option plan( "PRECOMPILED_JSON_MAPGEN", "true" );
+            planned = generate( terrain );
+        }
+        generated_map pieces;
+        {
+            override_option plan( "PRECOMPILED_JSON_MAPGEN", "false" );
+            pieces = generate( terrain );
+        }
+        CHECK( planned.squares == pieces.squares );
+        CHECK( planned.items == pieces.items );
+        CHECK( planned.rng_state == pieces.rng_state );
+    }
+    MAPBUFFER.clear();
+}
+
+TEST_CASE( "json_mapgen_benchmark", "[.][mapgen][benchmark]" )
+{
+    clear_all_state();
+    const tripoint_abs_omt pos( 10, 10, 0 );
+    overmap_buffer.ter_set( pos, oter_id( "house_01_north" ) );
+    const tripoint_abs_sm sm_pos = project_to<coords::sm>( pos );
+
+    BENCHMARK( "generate a house" ) {
+        MAPBUFFER.clear();
+        tinymap tm;
+        tm.generate( sm_pos.raw(), calendar::turn );
+        return tm.ter( point_zero );
+    };
+    MAPBUFFER.clear();
+}
@@ -68,3 +68,34 @@ TEST_CASE( "om_noise_layer_lake_export", "[.]" )
     export_raw_noise( "lake-map-raw.pgm", f, OMAPX * 5, OMAPY * 5 );
     export_interpreted_noise( "lake-map-interp.pgm", f, OMAPX * 5, OMAPY * 5, 0.25 );
 }
+
+TEST_CASE( "om_noise_grid_matches_layer", "[overmap]" )
+{
+    const om_noise::om_noise_layer_forest f( point_abs_omt( 360, -180 ), 1920237457 );
+    const om_noise::om_noise_grid grid( f );
+    for( int x = -1; x <= OMAPX; x++ ) {
+        for( int y = -1; y <= OMAPY; y++ ) {
+            const point_om_omt p( x, y );
+            INFO( p.to_string() );
+            CHECK( grid.noise_at( p ) == f.noise_at( p ) );
+        }
+    }
+}
+
+TEST_CASE( "om_noise_grid_benchmark", "[.][overmap][benchmark]" )
+{
+    const om_noise::om_noise_layer_lake f( point_abs_omt(), 1920237457 );
+    BENCHMARK( "noise_at per terrain" ) {
+        float sum = 0.0f;
+        for( int x = 0; x < OMAPX; x++ ) {
+            for( int y = 0; y < OMAPY; y++ ) {
+                sum += f.noise_at( { x, y } );
+            }
+        }
+        return sum;
+    };
+    BENCHMARK( "om_noise_grid" ) {
+        const om_noise::om_noise_grid grid( f );
+        return grid.noise_at( { OMAPX / 2, OMAPY / 2 } );
+    };
+}
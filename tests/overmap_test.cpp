@@ -213,3 +213,34 @@ TEST_CASE( "mutable_overmap_placement", "[overmap][slow]" )
         CHECK( successes > num_trials_per_overmap / 2 );
     }
 }
+
+TEST_CASE( "overmap_generated_ahead_is_returned_by_get", "[overmap][slow]" )
+{
+    clear_all_state();
+    const point_abs_om origin;
+    overmap_buffer.get( origin );
+    // A few terrains from the east edge, so only the east neighbor is in range.
+    const tripoint_abs_omt near_east_edge( OMAPX - 5, OMAPY / 2, 0 );
+    overmap_buffer.generate_ahead( near_east_edge, 10 );
+    overmap_buffer.finish_generating_ahead( true );
+
+    // get_existing doesn't generate overmaps, so this one can only come from generate_ahead.
+    const point_abs_om east = origin + point_east;
+    const overmap *generated = overmap_buffer.get_existing( east );
+    REQUIRE( generated != nullptr );
+    CHECK( generated->pos() == east );
+    CHECK( &overmap_buffer.get( east ) == generated );
+}
+
+TEST_CASE( "overmap_generation_benchmark", "[.][overmap][benchmark]" )
+{
+    clear_all_state();
+    const point_abs_om origin;
+    BENCHMARK( "generate a default overmap" ) {
+        overmap_buffer.clear();
+        overmap_special_batch batch = overmap_specials::get_default_batch( origin );
+        overmap_buffer.create_custom_overmap( origin, batch );
+        return overmap_buffer.has( origin );
+    };
+    overmap_buffer.clear();
+}
@@ -0,0 +1,264 @@
+#include "catch/catch.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "line.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "options_helpers.h"
+#include "pathfinding.h"
+#include "point.h"
+#include "state_helpers.h"
+#include "type_id.h"
+
+static const std::vector<tripoint> flow_goals = {
+    tripoint( 40, 60, 0 ), tripoint( 80, 40, 0 ), tripoint( 80, 80, 0 ), tripoint( 110, 110, 0 )
+};
+
+// Walled in, so no goal can be reached from inside
+static const tripoint enclosed_start( 120, 3, 0 );
+
+static void build_flow_test_map()
+{
+    clear_all_state();
+    map &here = get_map();
+    for( int y = 30; y <= 90; y++ ) {
+        here.ter_set( tripoint( 60, y, 0 ), t_wall );
+    }
+    for( int x = 118; x <= 122; x++ ) {
+        here.ter_set( tripoint( x, 1, 0 ), t_wall );
+        here.ter_set( tripoint( x, 5, 0 ), t_wall );
+    }
+    for( int y = 1; y <= 5; y++ ) {
+        here.ter_set( tripoint( 118, y, 0 ), t_wall );
+        here.ter_set( tripoint( 122, y, 0 ), t_wall );
+    }
+    Pathfinding::clear_d_maps();
+}
+
+// 200 monsters spread over the map, clear of walls and goals
+static std::vector<tripoint> flow_test_monsters()
+{
+    std::vector<tripoint> monsters;
+    for( int x = 12; x < 122; x += 11 ) {
+        for( int y = 7; y < 127; y += 6 ) {
+            monsters.emplace_back( x + ( y % 4 ), y, 0 );
+        }
+    }
+    return monsters;
+}
+
+TEST_CASE( "flow_field_routes_lead_to_the_closest_goal", "[pathfinding]" )
+{
+    build_flow_test_map();
+    const map &here = get_map();
+    const std::vector<tripoint> monsters = flow_test_monsters();
+    REQUIRE( monsters.size() == 200 );
+
+    for( const tripoint &start : monsters ) {
+        CAPTURE( start );
+        const std::vector<tripoint> path = Pathfinding::flow_route( start, flow_goals );
+        REQUIRE( path.size() >= 2 );
+        CHECK( path.front() == start );
+        const tripoint goal = path.back();
+        CHECK( std::ranges::find( flow_goals, goal ) != flow_goals.end() );
+        for( size_t i = 1; i < path.size(); i++ ) {
+            CHECK( square_dist( path[i - 1], path[i] ) == 1 );
+            CHECK( here.passable( path[i] ) );
+        }
+
+        // Same goal as a regular route would reach
+        CHECK_FALSE( Pathfinding::route( start, goal ).empty() );
+        // Asking for a particular goal only works for the closest one
+        for( const tripoint &other : flow_goals ) {
+            CHECK( Pathfinding::flow_route( start, flow_goals, other ).empty() == ( other != goal ) );
+        }
+    }
+
+    CHECK( Pathfinding::flow_route( enclosed_start, flow_goals ).empty() );
+    CHECK( Pathfinding::route( enclosed_start, flow_goals.front() ).empty() );
+}
+
+TEST_CASE( "flow_field_ignores_other_z_levels", "[pathfinding]" )
+{
+    build_flow_test_map();
+    const tripoint start( 20, 20, 0 );
+    CHECK( Pathfinding::flow_route( start, { tripoint( 40, 40, -1 ) } ).empty() );
+    const std::vector<tripoint> path = Pathfinding::flow_route( start, {
+        tripoint( 40, 40, -1 ), tripoint( 30, 30, 0 )
+    } );
+    REQUIRE_FALSE( path.empty() );
+    CHECK( path.back() == tripoint( 30, 30, 0 ) );
+}
+
+// A long wall with a way around it at the bottom of the map
+static void build_detour_test_map()
+{
+    clear_all_state();
+    map &here = get_map();
+    for( int y = 0; y < 120; y++ ) {
+        here.ter_set( tripoint( 66, y, 0 ), t_wall );
+    }
+    Pathfinding::clear_d_maps();
+}
+
+static const tripoint detour_start( 20, 30, 0 );
+static const tripoint detour_end( 110, 30, 0 );
+
+static void check_route( const std::vector<tripoint> &path, const tripoint &from,
+                         const tripoint &to )
+{
+    const map &here = get_map();
+    REQUIRE( path.size() >= 2 );
+    CHECK( path.front() == from );
+    CHECK( path.back() == to );
+    for( size_t i = 1; i < path.size(); i++ ) {
+        CHECK( square_dist( path[i - 1], path[i] ) == 1 );
+        CHECK( here.passable( path[i] ) );
+    }
+}
+
+TEST_CASE( "hierarchical_routes_expand_fewer_tiles", "[pathfinding]" )
+{
+    build_detour_test_map();
+
+    uint64_t regular_expansions = 0;
+    {
+        override_option hierarchical( "USE_HIERARCHICAL_PATHFINDING", "false" );
+        const uint64_t before = Pathfinding::expansion_count();
+        check_route( Pathfinding::route( detour_start, detour_end ), detour_start, detour_end );
+        regular_expansions = Pathfinding::expansion_count() - before;
+    }
+
+    override_option hierarchical( "USE_HIERARCHICAL_PATHFINDING", "true" );
+    // First route builds the chunks, which are kept for later turns
+    Pathfinding::clear_d_maps();
+    check_route( Pathfinding::route( detour_start, detour_end ), detour_start, detour_end );
+
+    Pathfinding::clear_d_maps();
+    const uint64_t before = Pathfinding::expansion_count();
+    const std::vector<tripoint> path = Pathfinding::route( detour_start, detour_end );
+    const uint64_t hierarchical_expansions = Pathfinding::expansion_count() - before;
+    check_route( path, detour_start, detour_end );
+    CAPTURE( regular_expansions, hierarchical_expansions );
+    CHECK( hierarchical_expansions < regular_expansions );
+
+    SECTION( "changed chunks are rebuilt" ) {
+        // Close the way around, leaving a gap in the middle instead
+        map &here = get_map();
+        for( int y = 120; y < MAPSIZE_Y; y++ ) {
+            here.ter_set( tripoint( 66, y, 0 ), t_wall );
+        }
+        here.ter_set( tripoint( 66, 60, 0 ), t_grass );
+        Pathfinding::clear_d_maps();
+        const std::vector<tripoint> new_path = Pathfinding::route( detour_start, detour_end );
+        check_route( new_path, detour_start, detour_end );
+        CHECK( std::ranges::find( new_path, tripoint( 66, 60, 0 ) ) != new_path.end() );
+    }
+}
+
+TEST_CASE( "long_routes_are_found_in_the_background", "[pathfinding]" )
+{
+    build_detour_test_map();
+    const map &here = get_map();
+
+    const auto request = Pathfinding::request_route( detour_start, detour_end );
+    CHECK_FALSE( Pathfinding::collect_route( request ).has_value() );
+
+    Pathfinding::dispatch_route_requests();
+    request.wait();
+    const std::optional<std::vector<tripoint>> path = Pathfinding::collect_route( request );
+    REQUIRE( path.has_value() );
+    check_route( *path, detour_start, detour_end );
+    // Results are kept in absolute coords
+    for( size_t i = 0; i < path->size(); i++ ) {
+        CHECK( request.get()[i] == here.getabs( ( *path )[i] ) );
+    }
+
+    SECTION( "unreachable" ) {
+        for( int x = -2; x <= 2; x++ ) {
+            for( int y = -2; y <= 2; y++ ) {
+                if( std::abs( x ) == 2 || std::abs( y ) == 2 ) {
+                    get_map().ter_set( enclosed_start + point( x, y ), t_wall );
+                }
+            }
+        }
+        const auto walled_in = Pathfinding::request_route( detour_start, enclosed_start );
+        Pathfinding::dispatch_route_requests();
+        walled_in.wait();
+        const std::optional<std::vector<tripoint>> no_path = Pathfinding::collect_route( walled_in );
+        REQUIRE( no_path.has_value() );
+        CHECK( no_path->empty() );
+    }
+
+    SECTION( "dropped by clear_d_maps before being handed out" ) {
+        const auto dropped = Pathfinding::request_route( detour_start, detour_end );
+        Pathfinding::clear_d_maps();
+        const std::optional<std::vector<tripoint>> no_path = Pathfinding::collect_route( dropped );
+        REQUIRE( no_path.has_value() );
+        CHECK( no_path->empty() );
+    }
+}
+
+TEST_CASE( "short_routes_are_found_right_away", "[pathfinding]" )
+{
+    build_detour_test_map();
+    const tripoint from( 60, 30, 0 );
+    const tripoint to( 72, 30, 0 );
+
+    const auto request = Pathfinding::request_route( from, to );
+    const std::optional<std::vector<tripoint>> path = Pathfinding::collect_route( request );
+    REQUIRE( path.has_value() );
+    check_route( *path, from, to );
+}
+
+TEST_CASE( "flow_field_benchmark", "[.][pathfinding][benchmark]" )
+{
+    build_flow_test_map();
+    const std::vector<tripoint> monsters = flow_test_monsters();
+    // What monsters chase without flow fields, each its own closest goal
+    std::vector<tripoint> closest_goals;
+    for( const tripoint &start : monsters ) {
+        closest_goals.push_back( *std::ranges::min_element( flow_goals, [&start]( const tripoint & a,
+        const tripoint & b ) {
+            return rl_dist( start, a ) < rl_dist( start, b );
+        } ) );
+    }
+
+    BENCHMARK( "per-destination d_maps, 200 monsters" ) {
+        Pathfinding::clear_d_maps();
+        size_t steps = 0;
+        for( size_t i = 0; i < monsters.size(); i++ ) {
+            steps += Pathfinding::route( monsters[i], closest_goals[i] ).size();
+        }
+        return steps;
+    };
+    BENCHMARK( "flow field, 200 monsters" ) {
+        Pathfinding::clear_d_maps();
+        size_t steps = 0;
+        for( const tripoint &start : monsters ) {
+            steps += Pathfinding::flow_route( start, flow_goals ).size();
+        }
+        return steps;
+    };
+}
+
+TEST_CASE( "hierarchical_pathfinding_benchmark", "[.][pathfinding][benchmark]" )
+{
+    build_detour_test_map();
+
+    BENCHMARK( "regular route around a wall" ) {
+        override_option hierarchical( "USE_HIERARCHICAL_PATHFINDING", "false" );
+        Pathfinding::clear_d_maps();
+        return Pathfinding::route( detour_start, detour_end ).size();
+    };
+    BENCHMARK( "hierarchical route around a wall" ) {
+        override_option hierarchical( "USE_HIERARCHICAL_PATHFINDING", "true" );
+        Pathfinding::clear_d_maps();
+        return Pathfinding::route( detour_start, detour_end ).size();
+    };
+}
@@ -78,3 +78,18 @@ TEST_CASE( "random_entry_preserves_constness" )
     i1 = 5678;
     CHECK( v1[0] == 5678 );
 }
+
+TEST_CASE( "rng_seed_scope_is_reproducible_and_restores_the_engine", "[rng]" )
+{
+    const auto roll_seeded = []() {
+        const rng_seed_scope seeded( 1234 );
+        return std::vector<int> { rng( 0, 1000 ), rng( 0, 1000 ), rng( 0, 1000 ) };
+    };
+
+    const cata_default_random_engine before = rng_get_engine();
+    const std::vector<int> first = roll_seeded();
+    CHECK( rng_get_engine() == before );
+
+    rng( 0, 1000 );
+    CHECK( roll_seeded() == first );
+}
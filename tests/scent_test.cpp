@@ -1,9 +1,11 @@
 
 #include "scent_map.h"
 #include "catch/catch.hpp"
+#include "line.h"
 #include "map.h"
 #include "map_helpers.h"
 #include "game.h"
+#include "options_helpers.h"
 #include "state_helpers.h"
 
 void old_scent_map_update( const tripoint &center, map &m,
@@ -170,3 +172,194 @@ TEST_CASE( "scent_matches_old", "[.]" )
     }
 }
 
+
+// The scalar kernel scent_map::update used before it worked on whole columns at a time
+static void reference_scent_map_update( const tripoint &center, map &m,
+                                        std::array<std::array<int, MAPSIZE_Y>, MAPSIZE_X> &grscent )
+{
+    std::array<std::array<char, MAPSIZE_Y>, MAPSIZE_X> scent_transfer;
+
+    std::array < std::array < int, 3 + SCENT_RADIUS * 2 >, 1 + SCENT_RADIUS * 2 > new_scent;
+    std::array < std::array < int, 3 + SCENT_RADIUS * 2 >, 1 + SCENT_RADIUS * 2 > sum_3_scent_y;
+    std::array < std::array < char, 3 + SCENT_RADIUS * 2 >, 1 + SCENT_RADIUS * 2 > squares_used_y;
+
+    diagonal_blocks( &blocked_cache )[MAPSIZE_X][MAPSIZE_Y] = m.access_cache(
+                center.z ).vehicle_obstructed_cache;
+
+    const int scentmap_minx = center.x - SCENT_RADIUS;
+    const int scentmap_maxx = center.x + SCENT_RADIUS;
+    const int scentmap_miny = center.y - SCENT_RADIUS;
+    const int scentmap_maxy = center.y + SCENT_RADIUS;
+
+    m.scent_blockers( scent_transfer, point( scentmap_minx - 1, scentmap_miny - 1 ),
+                      point( scentmap_maxx + 1, scentmap_maxy + 1 ) );
+
+    for( int x = 0; x < SCENT_RADIUS * 2 + 3; ++x ) {
+        for( int y = 0; y < SCENT_RADIUS * 2 + 1; ++y ) {
+            point abs( x + scentmap_minx - 1, y + scentmap_miny );
+            sum_3_scent_y[y][x] = 0;
+            squares_used_y[y][x] = 0;
+            for( int i = abs.y - 1; i <= abs.y + 1; ++i ) {
+                sum_3_scent_y[y][x] += scent_transfer[abs.x][i] * grscent[abs.x][i];
+                squares_used_y[y][x] += scent_transfer[abs.x][i];
+            }
+        }
+    }
+
+    for( int x = 1; x < SCENT_RADIUS * 2 + 2; ++x ) {
+        for( int y = 0; y < SCENT_RADIUS * 2 + 1; ++y ) {
+            const point abs( x + scentmap_minx - 1, y + scentmap_miny );
+
+            int squares_used = squares_used_y[y][x - 1] + squares_used_y[y][x] + squares_used_y[y][x + 1];
+            int total = sum_3_scent_y[y][x - 1] + sum_3_scent_y[y][x] + sum_3_scent_y[y][x + 1];
+
+            if( blocked_cache[abs.x][abs.y].nw && scent_transfer[abs.x + 1][abs.y + 1] == 5 ) {
+                squares_used -= 4;
+                total -= 4 * grscent[abs.x + 1][abs.y + 1];
+            }
+            if( blocked_cache[abs.x][abs.y].ne && scent_transfer[abs.x - 1][abs.y + 1] == 5 ) {
+                squares_used -= 4;
+                total -= 4 * grscent[abs.x - 1][abs.y + 1];
+            }
+            if( blocked_cache[abs.x - 1][abs.y - 1].nw && scent_transfer[abs.x - 1][abs.y - 1] == 5 ) {
+                squares_used -= 4;
+                total -= 4 * grscent[abs.x - 1][abs.y - 1];
+            }
+            if( blocked_cache[abs.x + 1][abs.y - 1].ne && scent_transfer[abs.x + 1][abs.y - 1] == 5 ) {
+                squares_used -= 4;
+                total -= 4 * grscent[abs.x + 1][abs.y - 1];
+            }
+
+            int temp_scent =  grscent[abs.x][abs.y] * ( 250 - squares_used  *
+                              scent_transfer[abs.x][abs.y] ) ;
+            temp_scent -=  grscent[abs.x][abs.y] * scent_transfer[abs.x][abs.y] *
+                           ( 45 - squares_used ) / 5;
+
+            new_scent[y][x] = ( temp_scent + total * scent_transfer[abs.x][abs.y] ) / 250;
+        }
+    }
+    for( int x = 1; x < SCENT_RADIUS * 2 + 2; ++x ) {
+        for( int y = 0; y < SCENT_RADIUS * 2 + 1; ++y ) {
+            grscent[x + scentmap_minx - 1 ][y + scentmap_miny] = new_scent[y][x];
+        }
+    }
+}
+
+// Walls, scent reducing half walls and a few vehicle diagonals around the origin
+static void build_scent_test_map( const tripoint &origin )
+{
+    clear_all_state();
+    g->place_player( origin );
+    map &here = get_map();
+    here.ter_set( origin + tripoint_south_west, t_brick_wall );
+    here.ter_set( origin + tripoint_west, t_brick_wall );
+    here.ter_set( origin + tripoint_north, t_rock_wall_half );
+    here.ter_set( origin + tripoint( 5, 3, 0 ), t_rock_wall_half );
+    for( int y = -20; y < 10; y++ ) {
+        here.ter_set( origin + tripoint( 12, y, 0 ), t_brick_wall );
+    }
+    auto &blocked = here.access_cache( origin.z ).vehicle_obstructed_cache;
+    for( int i = 0; i < 6; i++ ) {
+        blocked[origin.x - 8 + i][origin.y + 6].nw = true;
+        blocked[origin.x - 8 + i][origin.y + 9].ne = true;
+    }
+}
+
+static void clear_vehicle_diagonals( const tripoint &origin )
+{
+    for( auto &column : get_map().access_cache( origin.z ).vehicle_obstructed_cache ) {
+        for( diagonal_blocks &blocks : column ) {
+            blocks = { false, false };
+        }
+    }
+}
+
+TEST_CASE( "scent_diffusion_matches_the_scalar_kernel", "[scent]" )
+{
+    const tripoint origin( 60, 60, 0 );
+    build_scent_test_map( origin );
+    map &here = get_map();
+
+    std::array<std::array<int, MAPSIZE_Y>, MAPSIZE_X> expected;
+    g->scent.reset();
+    for( int x = 0; x < MAPSIZE_X; x++ ) {
+        for( int y = 0; y < MAPSIZE_Y; y++ ) {
+            // Strong scent around the origin, some noise everywhere
+            const int value = std::max( 0, 2000 - 40 * rl_dist( origin.xy(), point( x, y ) ) ) +
+                              ( x * 37 + y * 11 ) % 97;
+            expected[x][y] = value;
+            g->scent.set( tripoint( x, y, 0 ), value, scenttype_id( "sc_human" ) );
+        }
+    }
+
+    for( int turn = 0; turn < 10; turn++ ) {
+        g->scent.update( origin, here );
+        reference_scent_map_update( origin, here, expected );
+    }
+
+    for( int x = 0; x < MAPSIZE_X; x++ ) {
+        for( int y = 0; y < MAPSIZE_Y; y++ ) {
+            CAPTURE( x, y );
+            CHECK( g->scent.get( tripoint( x, y, 0 ) ) == std::max( 0, expected[x][y] ) );
+        }
+    }
+    clear_vehicle_diagonals( origin );
+}
+
+TEST_CASE( "scent_layers_keep_scent_types_apart", "[scent]" )
+{
+    const tripoint origin( 60, 60, 0 );
+    const tripoint human_spot = origin + tripoint( -10, 0, 0 );
+    const tripoint flower_spot = origin + tripoint( 10, 0, 0 );
+    clear_all_state();
+    g->place_player( origin );
+    map &here = get_map();
+
+    const auto leave_scents = [&]() {
+        g->scent.reset();
+        g->scent.set( human_spot, 1000, scenttype_id( "sc_human" ) );
+        g->scent.set( flower_spot, 1000, scenttype_id( "sc_flower" ) );
+        for( int turn = 0; turn < 5; turn++ ) {
+            g->scent.update( origin, here );
+        }
+    };
+
+    SECTION( "without layers, all scent is of the last type" ) {
+        override_option layers( "SCENT_LAYERS", "false" );
+        leave_scents();
+        CHECK( g->scent.get_type( human_spot ) == scenttype_id( "sc_flower" ) );
+        CHECK( g->scent.get_type( flower_spot ) == scenttype_id( "sc_flower" ) );
+    }
+    SECTION( "with layers, the strongest type is found" ) {
+        override_option layers( "SCENT_LAYERS", "true" );
+        leave_scents();
+        CHECK( g->scent.get_type( human_spot ) == scenttype_id( "sc_human" ) );
+        CHECK( g->scent.get_type( human_spot + tripoint_west ) == scenttype_id( "sc_human" ) );
+        CHECK( g->scent.get_type( flower_spot ) == scenttype_id( "sc_flower" ) );
+        CHECK( g->scent.get_type( flower_spot + tripoint_east ) == scenttype_id( "sc_flower" ) );
+    }
+}
+
+TEST_CASE( "scent_diffusion_benchmark", "[.][scent][benchmark]" )
+{
+    const tripoint origin( 60, 60, 0 );
+    build_scent_test_map( origin );
+    map &here = get_map();
+
+    std::array<std::array<int, MAPSIZE_Y>, MAPSIZE_X> reference;
+    for( auto &column : reference ) {
+        column.fill( 100 );
+    }
+    g->scent.reset();
+    g->scent.set( origin, 1000, scenttype_id( "sc_human" ) );
+
+    BENCHMARK( "scalar kernel" ) {
+        reference_scent_map_update( origin, here, reference );
+        return reference[origin.x][origin.y];
+    };
+    BENCHMARK( "column kernel" ) {
+        g->scent.update( origin, here );
+        return g->scent.get( origin );
+    };
+    clear_vehicle_diagonals( origin );
+}
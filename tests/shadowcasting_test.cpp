@@ -417,6 +417,80 @@ static void shadowcasting_3d_2d( const int iterations )
     REQUIRE( passed );
 }
 
+enum class shadowcasting_layout {
+    open_field,
+    city,
+    forest,
+};
+
+static void fill_layout( float ( &transparency_cache )[MAPSIZE * SEEX][MAPSIZE * SEEY],
+                         const shadowcasting_layout layout )
+{
+    std::uniform_int_distribution<int> distribution( 0, 99 );
+    auto rng = std::bind( distribution, rng_get_engine() );
+
+    for( int x = 0; x < MAPSIZE * SEEX; ++x ) {
+        for( int y = 0; y < MAPSIZE * SEEY; ++y ) {
+            float &square = transparency_cache[x][y];
+            square = LIGHT_TRANSPARENCY_OPEN_AIR;
+            switch( layout ) {
+                case shadowcasting_layout::open_field:
+                    break;
+                case shadowcasting_layout::city: {
+                    // 12x12 blocks: a 3 tile road, then a walled building with a doorway and windows.
+                    const int bx = x % 12;
+                    const int by = y % 12;
+                    const bool in_building = bx >= 3 && by >= 3;
+                    const bool wall = in_building && ( bx == 3 || bx == 11 || by == 3 || by == 11 );
+                    if( wall && !( bx == 7 && by == 3 ) ) {
+                        square = ( bx == 3 && by == 7 ) ? LIGHT_TRANSPARENCY_OPEN_AIR * 2 :
+                                 LIGHT_TRANSPARENCY_SOLID;
+                    }
+                    break;
+                }
+                case shadowcasting_layout::forest: {
+                    const int roll = rng();
+                    if( roll < 15 ) {
+                        square = LIGHT_TRANSPARENCY_SOLID;
+                    } else if( roll < 40 ) {
+                        square = LIGHT_TRANSPARENCY_OPEN_AIR * 5;
+                    }
+                    break;
+                }
+            }
+        }
+    }
+}
+
+static void shadowcasting_layout_benchmark( const shadowcasting_layout layout )
+{
+    static four_quadrants lit_squares[MAPSIZE * SEEX][MAPSIZE * SEEY];
+    static float transparency_cache[MAPSIZE * SEEX][MAPSIZE * SEEY];
+    static diagonal_blocks blocked_cache[MAPSIZE * SEEX][MAPSIZE * SEEY];
+
+    diagonal_blocks fill = {false, false};
+    std::uninitialized_fill_n( &blocked_cache[0][0], MAPSIZE * SEEX * MAPSIZE * SEEY, fill );
+    fill_layout( transparency_cache, layout );
+
+    const point offset( 65, 65 );
+
+    BENCHMARK( "castLightAll" ) {
+        std::uninitialized_fill_n( &lit_squares[0][0], MAPSIZE * SEEX * MAPSIZE * SEEY,
+                                   four_quadrants( 0.0f ) );
+        castLightAll<float, four_quadrants, sight_calc, sight_check, update_light_quadrants,
+                     accumulate_transparency>( lit_squares, transparency_cache, blocked_cache, offset );
+        return lit_squares[0][0].max();
+    };
+    BENCHMARK( "castLightAllWithLookup" ) {
+        std::uninitialized_fill_n( &lit_squares[0][0], MAPSIZE * SEEX * MAPSIZE * SEEY,
+                                   four_quadrants( 0.0f ) );
+        castLightAllWithLookup<float, four_quadrants, sight_calc, sight_check, update_light_quadrants,
+                               accumulate_transparency, sight_from_lookup>(
+                                   lit_squares, transparency_cache, blocked_cache, offset );
+        return lit_squares[0][0].max();
+    };
+}
+
 // T, O and V are 'T'ransparent, 'O'paque and 'V'isible.
 // X marks the player location, which is not set to visible by this algorithm.
 static constexpr float T = LIGHT_TRANSPARENCY_OPEN_AIR;
@@ -664,6 +738,20 @@ TEST_CASE( "shadowcasting_float_quad_performance", "[.]" )
     shadowcasting_float_quad( 1000000, 100 );
 }
 
+TEST_CASE( "shadowcasting_layout_benchmark", "[.][shadowcasting][benchmark]" )
+{
+    clear_all_state();
+    SECTION( "open field" ) {
+        shadowcasting_layout_benchmark( shadowcasting_layout::open_field );
+    }
+    SECTION( "city" ) {
+        shadowcasting_layout_benchmark( shadowcasting_layout::city );
+    }
+    SECTION( "forest" ) {
+        shadowcasting_layout_benchmark( shadowcasting_layout::forest );
+    }
+}
+
 // I'm not sure this will ever work.
 TEST_CASE( "bresenham_vs_shadowcasting", "[.]" )
 {
@@ -0,0 +1,71 @@
+#include "catch/catch.hpp"
+
+#include <vector>
+
+#include "simplexnoise.h"
+
+TEST_CASE( "raw_noise_3d_lanes_matches_raw_noise_3d", "[noise]" )
+{
+    // Whole and half coordinates hit the ties between simplex orderings.
+    std::vector<float> coords;
+    for( int i = -8; i <= 8; i++ ) {
+        coords.push_back( i * 0.5f );
+        coords.push_back( i * 0.37f + 0.11f );
+    }
+    for( float z : { -3.0f, 0.0f, 0.25f, 1234.5f } ) {
+        for( size_t first = 0; first < coords.size(); first += noise_lanes ) {
+            float x[noise_lanes];
+            float y[noise_lanes];
+            float zs[noise_lanes];
+            for( int l = 0; l < noise_lanes; l++ ) {
+                x[l] = coords[( first + l ) % coords.size()];
+                y[l] = coords[( first + l * 3 ) % coords.size()];
+                zs[l] = z + l * 0.5f;
+            }
+            float out[noise_lanes];
+            raw_noise_3d_lanes( x, y, zs, out );
+            for( int l = 0; l < noise_lanes; l++ ) {
+                INFO( x[l] << ", " << y[l] << ", " << zs[l] );
+                CHECK( out[l] == raw_noise_3d( x[l], y[l], zs[l] ) );
+            }
+        }
+    }
+}
+
+TEST_CASE( "scaled_octave_noise_3d_grid_matches_scalar", "[noise]" )
+{
+    // Neither dimension is a multiple of the lane count.
+    const int width = 37;
+    const int height = 23;
+    const float x = -50;
+    const float y = 120;
+    const float z = 12345;
+    std::vector<float> grid( width * height );
+    scaled_octave_noise_3d_grid( 8, 0.5, 0.03, 0, 1, x, y, z, width, height, grid.data() );
+    for( int i = 0; i < width; i++ ) {
+        for( int j = 0; j < height; j++ ) {
+            INFO( i << ", " << j );
+            const float expected = scaled_octave_noise_3d( 8, 0.5, 0.03, 0, 1, x + i, y + j, z );
+            CHECK( grid[i * height + j] == expected );
+        }
+    }
+}
+
+TEST_CASE( "scaled_octave_noise_3d_grid_benchmark", "[.][noise][benchmark]" )
+{
+    const int size = 180;
+    std::vector<float> grid( size * size );
+    BENCHMARK( "scaled_octave_noise_3d per point" ) {
+        float sum = 0.0f;
+        for( int i = 0; i < size; i++ ) {
+            for( int j = 0; j < size; j++ ) {
+                sum += scaled_octave_noise_3d( 16, 0.5, 0.002, 0, 1, i, j, 12345 );
+            }
+        }
+        return sum;
+    };
+    BENCHMARK( "scaled_octave_noise_3d_grid" ) {
+        scaled_octave_noise_3d_grid( 16, 0.5, 0.002, 0, 1, 0, 0, 12345, size, size, grid.data() );
+        return grid[size / 2];
+    };
+}
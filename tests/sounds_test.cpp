@@ -0,0 +1,91 @@
+#include "catch/catch.hpp"
+
+#include <string>
+
+#include "avatar.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "mapdata.h"
+#include "monster.h"
+#include "options_helpers.h"
+#include "point.h"
+#include "sounds.h"
+#include "state_helpers.h"
+
+static const tripoint listener_pos( 61, 61, 0 );
+static const tripoint sound_pos( 30, 61, 0 );
+
+// Three tiles of open space around the listener, then a ring of wall four tiles thick
+static void wall_in_listener()
+{
+    map &here = get_map();
+    for( int x = 56; x <= 67; x++ ) {
+        for( int y = 56; y <= 67; y++ ) {
+            if( x < 60 || x > 63 || y < 60 || y > 63 ) {
+                here.ter_set( tripoint( x, y, 0 ), t_wall );
+            }
+        }
+    }
+    here.build_map_cache( 0 );
+}
+
+static bool hears( const std::string &propagation, int volume, bool walled_in )
+{
+    clear_all_state();
+    get_avatar().setpos( tripoint( 10, 10, 0 ) );
+    if( walled_in ) {
+        wall_in_listener();
+    }
+    const monster &listener = spawn_test_monster( "mon_zombie", listener_pos );
+    REQUIRE( listener.wandf == 0 );
+
+    override_option sound_propagation( "SOUND_PROPAGATION", propagation );
+    sounds::sound( sound_pos, volume, sounds::sound_t::combat, "BOOM" );
+    sounds::process_sounds();
+    return listener.wandf > 0;
+}
+
+TEST_CASE( "monsters_hear_sounds_in_every_propagation_mode", "[sounds][monster]" )
+{
+    for( const std::string propagation : {
+             "clusters", "grid", "grid_walls"
+         } ) {
+        CAPTURE( propagation );
+        CHECK( hears( propagation, 40, false ) );
+        CHECK_FALSE( hears( propagation, 10, false ) );
+    }
+}
+
+TEST_CASE( "walls_muffle_sounds_on_the_sound_grid", "[sounds][monster]" )
+{
+    CHECK( hears( "clusters", 40, true ) );
+    CHECK( hears( "grid", 40, true ) );
+    CHECK_FALSE( hears( "grid_walls", 40, true ) );
+    CHECK( hears( "grid_walls", 80, true ) );
+}
+
+TEST_CASE( "sound_grid_falls_back_when_the_cells_sound_is_out_of_range", "[sounds][monster]" )
+{
+    // The listener is in the corner of the cell spanning 60-63.  The quiet sound is the
+    // loudest at the center of that cell, but doesn't reach the corner, the other one does.
+    const tripoint corner( 60, 60, 0 );
+    const tripoint quiet_pos( 64, 62, 0 );
+    const tripoint far_pos( 51, 60, 0 );
+    for( const bool with_far_sound : {
+             false, true
+         } ) {
+        CAPTURE( with_far_sound );
+        clear_all_state();
+        get_avatar().setpos( tripoint( 10, 10, 0 ) );
+        const monster &listener = spawn_test_monster( "mon_zombie", corner );
+        REQUIRE( listener.wandf == 0 );
+
+        override_option sound_propagation( "SOUND_PROPAGATION", "grid" );
+        sounds::sound( quiet_pos, 2, sounds::sound_t::combat, "click" );
+        if( with_far_sound ) {
+            sounds::sound( far_pos, 10, sounds::sound_t::combat, "BOOM" );
+        }
+        sounds::process_sounds();
+        CHECK( ( listener.wandf > 0 ) == with_far_sound );
+    }
+}
@@ -8,6 +8,7 @@
 #include "game.h"
 #include "map.h"
 #include "name.h"
+#include "pathfinding.h"
 
 void clear_all_state( )
 {
@@ -17,6 +18,7 @@ void clear_all_state( )
     clear_avatar();
     set_time( calendar::turn_zero );
     Name::clear();
+    Pathfinding::clear_d_maps();
 
 
     cleanup_arenas();
@@ -0,0 +1,184 @@
+#include "catch/catch.hpp"
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "game.h"
+#include "game_constants.h"
+#include "json.h"
+#include "mapdata.h"
+#include "point.h"
+#include "submap.h"
+#include "submap_binary.h"
+#include "trap.h"
+#include "type_id.h"
+
+static const std::vector<tripoint> quad_positions = {
+    tripoint( 10, 20, 0 ), tripoint( 10, 21, 0 ), tripoint( 11, 20, 0 ), tripoint( 11, 21, 0 )
+};
+
+static std::unique_ptr<submap> make_test_submap( const tripoint &pos, const int seed )
+{
+    const std::vector<ter_id> ters = {
+        ter_str_id( "t_dirt" ).id(), ter_str_id( "t_grass" ).id(), ter_str_id( "t_floor" ).id()
+    };
+    auto sm = std::make_unique<submap>( sm_to_ms_copy( pos ) );
+    for( int x = 0; x < SEEX; x++ ) {
+        for( int y = 0; y < SEEY; y++ ) {
+            const point p( x, y );
+            // Long runs with a few breaks, like real terrain
+            sm->set_ter( p, ters[( ( x + seed ) / 4 + ( y == 3 ? 1 : 0 ) ) % ters.size()] );
+            if( ( x + y + seed ) % 7 == 0 ) {
+                sm->set_furn( p, furn_str_id( "f_chair" ).id() );
+            }
+            if( x == y ) {
+                sm->set_radiation( p, x + seed );
+            }
+        }
+    }
+    sm->set_trap( point( 2, 5 ), trap_str_id( "tr_beartrap" ).id() );
+    sm->set_temperature( 10 + seed );
+    return sm;
+}
+
+// Owns a quad of test submaps at quad_positions
+struct test_quad {
+    std::vector<std::unique_ptr<submap>> submaps;
+    std::vector<std::pair<tripoint, const submap *>> quad;
+
+    test_quad() {
+        for( size_t i = 0; i < quad_positions.size(); i++ ) {
+            submaps.push_back( make_test_submap( quad_positions[i], i ) );
+            quad.emplace_back( quad_positions[i], submaps.back().get() );
+        }
+    }
+};
+
+static std::string write_json_quad( const std::vector<std::pair<tripoint, const submap *>> &quad )
+{
+    // Same layout as mapbuffer::save_quad
+    std::ostringstream out;
+    JsonOut jsout( out );
+    jsout.start_array();
+    for( const auto &elem : quad ) {
+        jsout.start_object();
+        jsout.member( "version", savegame_version );
+        jsout.member( "coordinates" );
+        jsout.start_array();
+        jsout.write( elem.first.x );
+        jsout.write( elem.first.y );
+        jsout.write( elem.first.z );
+        jsout.end_array();
+        elem.second->store( jsout );
+        jsout.end_object();
+    }
+    jsout.end_array();
+    return out.str();
+}
+
+TEST_CASE( "binary_map_quads_convert_losslessly", "[submap][savegame]" )
+{
+    const test_quad fixture;
+    const std::vector<std::pair<tripoint, const submap *>> &quad = fixture.quad;
+    const std::string json = write_json_quad( quad );
+
+    std::istringstream json_in( json );
+    std::ostringstream binary;
+    submap_binary::json_to_binary( json_in, binary );
+
+    std::istringstream binary_in( binary.str() );
+    CHECK( submap_binary::is_binary_quad( binary_in ) );
+    std::ostringstream json_again;
+    submap_binary::binary_to_json( binary_in, json_again );
+    CHECK( json_again.str() == json );
+
+    std::ostringstream written;
+    submap_binary::write_quad( written, quad );
+    CHECK( written.str() == binary.str() );
+
+    std::istringstream not_binary( json );
+    CHECK_FALSE( submap_binary::is_binary_quad( not_binary ) );
+}
+
+TEST_CASE( "binary_map_quads_round_trip", "[submap][savegame]" )
+{
+    const test_quad fixture;
+    const std::vector<std::pair<tripoint, const submap *>> &quad = fixture.quad;
+    std::ostringstream binary;
+    submap_binary::write_quad( binary, quad );
+
+    std::istringstream binary_in( binary.str() );
+    size_t loaded = 0;
+    submap_binary::read_quad( binary_in, [&]( const tripoint & pos, std::unique_ptr<submap> &sm ) {
+        REQUIRE( loaded < quad.size() );
+        CHECK( pos == quad[loaded].first );
+        const submap &original = *quad[loaded].second;
+        for( int x = 0; x < SEEX; x++ ) {
+            for( int y = 0; y < SEEY; y++ ) {
+                const point p( x, y );
+                CHECK( sm->get_ter( p ) == original.get_ter( p ) );
+                CHECK( sm->get_furn( p ) == original.get_furn( p ) );
+                CHECK( sm->get_trap( p ) == original.get_trap( p ) );
+                CHECK( sm->get_radiation( p ) == original.get_radiation( p ) );
+            }
+        }
+        CHECK( sm->get_temperature() == original.get_temperature() );
+        loaded++;
+    } );
+    CHECK( loaded == quad.size() );
+}
+
+TEST_CASE( "binary_map_quads_benchmark", "[.][submap][savegame][benchmark]" )
+{
+    const test_quad fixture;
+    const std::vector<std::pair<tripoint, const submap *>> &quad = fixture.quad;
+    const std::string json = write_json_quad( quad );
+    std::ostringstream binary_out;
+    submap_binary::write_quad( binary_out, quad );
+    const std::string binary = binary_out.str();
+
+    BENCHMARK( "save json" ) {
+        return write_json_quad( quad ).size();
+    };
+    BENCHMARK( "save binary" ) {
+        std::ostringstream out;
+        submap_binary::write_quad( out, quad );
+        return out.str().size();
+    };
+    BENCHMARK( "load json" ) {
+        std::istringstream in( json );
+        JsonIn jsin( in );
+        size_t count = 0;
+        jsin.start_array();
+        while( !jsin.end_array() ) {
+            tripoint pos;
+            int version = 0;
+            std::unique_ptr<submap> sm;
+            jsin.start_object();
+            while( !jsin.end_object() ) {
+                const std::string name = jsin.get_member_name();
+                if( name == "version" ) {
+                    version = jsin.get_int();
+                } else if( name == "coordinates" ) {
+                    jsin.read( pos );
+                    sm = std::make_unique<submap>( sm_to_ms_copy( pos ) );
+                } else {
+                    sm->load( jsin, name, version, multiply_xy( pos, 12 ) );
+                }
+            }
+            count++;
+        }
+        return count;
+    };
+    BENCHMARK( "load binary" ) {
+        std::istringstream in( binary );
+        size_t count = 0;
+        submap_binary::read_quad( in, [&]( const tripoint &, std::unique_ptr<submap> & ) {
+            count++;
+        } );
+        return count;
+    };
+}